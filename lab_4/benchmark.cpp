@@ -0,0 +1,156 @@
+#include "concurrent_set.h"
+#include "hash_stats.h"
+#include "person.h"
+#include "person_generator.h"
+#include "person_snapshot.h"
+#include "person_table.h"
+#include "profile.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Запит "усі вищі за 180 см із заданого міста": рядки проти колонок
+void BenchmarkTableScan(const vector<Person>& people, const string& city) {
+    const int rounds = 20;
+    size_t rows_count = 0;
+    size_t table_count = 0;
+
+    {
+        LOG_DURATION("vector<Person> scan x" + to_string(rounds));
+        for (int round = 0; round < rounds; ++round) {
+            rows_count = 0;
+            for (const Person& person : people) {
+                if (person.height > 180 && person.address.city == city) {
+                    ++rows_count;
+                }
+            }
+        }
+    }
+
+    PersonTable table(people.begin(), people.end());
+    {
+        LOG_DURATION("PersonTable scan x" + to_string(rounds));
+        for (int round = 0; round < rounds; ++round) {
+            Selection selection = table.SelectHeight(Compare::Greater, 180);
+            selection &= table.SelectCity(city);
+            table_count = selection.Count();
+        }
+    }
+
+    if (rows_count != table_count) {
+        cerr << "Mismatch: " << rows_count << " != " << table_count << endl;
+    }
+    cerr << "Matched " << table_count << " of " << people.size() << endl;
+}
+
+// Слабкий хешер для порівняння: ігнорує все, крім імені
+struct NameOnlyHasher {
+    size_t operator()(const Person& person) const {
+        return hash<string>{}(person.name);
+    }
+};
+
+template <typename Hasher>
+void BenchmarkHasher(const string& title, const Hasher& hasher, size_t count) {
+    for (double duplicate_share : {0.0, 0.5, 0.9}) {
+        const vector<Person> people = GeneratePeopleWithDuplicates(count, duplicate_share);
+        auto flipper = [](const Person& person, auto callback) {
+            ForEachBitFlip(person, callback);
+        };
+        cerr << "== " << title << ", duplicates " << duplicate_share << " ==\n"
+             << AnalyzeHasher(people, hasher, flipper);
+    }
+}
+
+// Кожен потік вставляє свою частину people; insert - спосіб вставки одного елемента
+template <typename Insert>
+void InsertFromThreads(const vector<Person>& people, size_t thread_count, Insert insert) {
+    vector<thread> threads;
+    const size_t slice = (people.size() + thread_count - 1) / thread_count;
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            const size_t end = min(people.size(), (t + 1) * slice);
+            for (size_t i = t * slice; i < end; ++i) {
+                insert(people[i]);
+            }
+        });
+    }
+    for (thread& th : threads) {
+        th.join();
+    }
+}
+
+void BenchmarkConcurrentSet(size_t count) {
+    const vector<Person> people = GeneratePeopleWithDuplicates(count, 0.5);
+    for (size_t thread_count = 1; thread_count <= 32; thread_count *= 2) {
+        const string suffix = " (" + to_string(thread_count) + " threads)";
+        {
+            LOG_DURATION("mutex + unordered_set" + suffix);
+            mutex m;
+            unordered_set<Person, PersonHasher> set;
+            InsertFromThreads(people, thread_count, [&](const Person& person) {
+                lock_guard<mutex> guard(m);
+                set.insert(person);
+            });
+        }
+        {
+            LOG_DURATION("ConcurrentPersonSet" + suffix);
+            ConcurrentPersonSet set;
+            InsertFromThreads(people, thread_count, [&](const Person& person) {
+                set.Insert(person);
+            });
+        }
+        {
+            LOG_DURATION("ConcurrentPersonSet::BulkInsert" + suffix);
+            ConcurrentPersonSet set;
+            set.BulkInsert(people, thread_count);
+        }
+    }
+}
+
+void BenchmarkSnapshot(const vector<Person>& people) {
+    const string path = "people.snapshot";
+    {
+        LOG_DURATION("Build PersonSet from records");
+        PersonSet set(people.begin(), people.end());
+    }
+    {
+        LOG_DURATION("SaveSnapshot");
+        ofstream output(path, ios::binary);
+        SaveSnapshot(people, output);
+    }
+    {
+        LOG_DURATION("Map snapshot and probe every person");
+        MappedFile file(path);
+        SnapshotView snapshot(file.Data());
+        size_t found = 0;
+        for (const Person& person : people) {
+            found += snapshot.Contains(MakeView(person));
+        }
+        cerr << "Found " << found << " of " << people.size() << endl;
+    }
+    {
+        LOG_DURATION("LoadPersonSet from mapped snapshot");
+        MappedFile file(path);
+        HashedPersonSet set = LoadPersonSet(SnapshotView(file.Data()));
+    }
+    remove(path.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const vector<Person> people = GeneratePeople(count);
+
+    BenchmarkTableScan(people, people.front().address.city);
+    BenchmarkHasher("PersonHasher", PersonHasher{}, count / 10);
+    BenchmarkHasher("NameOnlyHasher", NameOnlyHasher{}, count / 10);
+    BenchmarkConcurrentSet(count);
+    BenchmarkSnapshot(people);
+    return 0;
+}
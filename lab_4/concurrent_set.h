@@ -0,0 +1,130 @@
+#ifndef CONCURRENT_SET_H
+#define CONCURRENT_SET_H
+
+#include "person.h"
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+// Хеш-множина, поділена на шарди з окремим м'ютексом у кожному:
+// потоки, що потрапляють у різні шарди, не чекають один на одного
+template <typename T, typename Hasher = std::hash<T>, typename Equal = std::equal_to<T>>
+class ConcurrentSet {
+public:
+    // shard_count = 0 трактується як один шард
+    explicit ConcurrentSet(size_t shard_count = 64, const Hasher& hasher = Hasher())
+        : hasher(hasher)
+        , shards(std::max<size_t>(shard_count, 1))
+    {
+        for (Shard& shard : shards) {
+            shard.items = Set(0, hasher);
+        }
+    }
+
+    // Повертає true, якщо елемента ще не було
+    bool Insert(T value) {
+        Shard& shard = GetShard(value);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        return shard.items.insert(std::move(value)).second;
+    }
+
+    // Приймає будь-який ключ, який розуміють Hasher і Equal (наприклад, PersonView)
+    template <typename Key>
+    bool Contains(const Key& key) const {
+        const Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        return shard.items.find(key) != shard.items.end();
+    }
+
+    // Спочатку потоки розкладають елементи по шардах, потім кожен потік
+    // вставляє свою групу шардів, тож за м'ютекс ніхто не змагається.
+    // Повертає кількість нових елементів
+    size_t BulkInsert(std::vector<T> values, size_t thread_count) {
+        thread_count = std::max<size_t>(1, std::min(thread_count, shards.size()));
+        const size_t slice = (values.size() + thread_count - 1) / thread_count;
+
+        std::vector<std::vector<std::vector<T>>> partitions(thread_count);
+        std::vector<std::future<void>> splitters;
+        for (size_t t = 0; t < thread_count; ++t) {
+            splitters.push_back(std::async(std::launch::async, [&, t] {
+                std::vector<std::vector<T>>& parts = partitions[t];
+                parts.resize(shards.size());
+                const size_t end = std::min(values.size(), (t + 1) * slice);
+                for (size_t i = t * slice; i < end; ++i) {
+                    parts[ShardIndex(values[i])].push_back(std::move(values[i]));
+                }
+            }));
+        }
+        for (auto& splitter : splitters) {
+            splitter.get();
+        }
+
+        std::vector<std::future<size_t>> inserters;
+        for (size_t t = 0; t < thread_count; ++t) {
+            inserters.push_back(std::async(std::launch::async, [&, t] {
+                size_t inserted = 0;
+                for (size_t index = t; index < shards.size(); index += thread_count) {
+                    Shard& shard = shards[index];
+                    std::lock_guard<std::mutex> guard(shard.mutex);
+                    for (auto& parts : partitions) {
+                        for (T& value : parts[index]) {
+                            inserted += shard.items.insert(std::move(value)).second;
+                        }
+                    }
+                }
+                return inserted;
+            }));
+        }
+
+        size_t inserted = 0;
+        for (auto& inserter : inserters) {
+            inserted += inserter.get();
+        }
+        return inserted;
+    }
+
+    size_t Size() const {
+        size_t size = 0;
+        for (const Shard& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard.mutex);
+            size += shard.items.size();
+        }
+        return size;
+    }
+
+private:
+    using Set = std::unordered_set<T, Hasher, Equal>;
+
+    // Вирівнювання по кеш-лінії прибирає хибне спільне використання м'ютексів
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        Set items;
+    };
+
+    // Старші біти хешу не корелюють з номером кошика всередині шарда
+    template <typename Key>
+    size_t ShardIndex(const Key& key) const {
+        const size_t hash = hasher(key) * 0x9E3779B97F4A7C15ull;
+        return (hash >> 32) % shards.size();
+    }
+
+    template <typename Key>
+    Shard& GetShard(const Key& key) {
+        return shards[ShardIndex(key)];
+    }
+
+    template <typename Key>
+    const Shard& GetShard(const Key& key) const {
+        return shards[ShardIndex(key)];
+    }
+
+    Hasher hasher;
+    std::vector<Shard> shards;
+};
+
+using ConcurrentPersonSet = ConcurrentSet<Person, PersonHasher, PersonEqual>;
+
+#endif // CONCURRENT_SET_H
@@ -1,82 +1,22 @@
+#include "concurrent_set.h"
+#include "hash_stats.h"
+#include "person.h"
+#include "person_generator.h"
+#include "person_snapshot.h"
+#include "person_table.h"
 #include "test_runner.h"
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
 #include <functional>
+#include <thread>
 
 using namespace std;
 
-struct Address {
-    string city, street;
-    int building;
-
-    bool operator==(const Address& other) const {
-        return city == other.city &&
-               street == other.street &&
-               building == other.building;
-    }
-};
-
-struct Person {
-    string name;
-    int height;
-    double weight;
-    Address address;
-
-    bool operator==(const Person& other) const {
-        return name == other.name &&
-               height == other.height &&
-               weight == other.weight &&
-               address == other.address;
-    }
-};
-
-struct AddressHasher {
-    size_t operator()(const Address& address) const {
-        const size_t coef = 514'229;
-        const hash<string> string_hasher;
-        const hash<int> int_hasher;
-
-        return coef * coef * string_hasher(address.city) +
-               coef * string_hasher(address.street) +
-               int_hasher(address.building);
-    }
-};
-
-struct PersonHasher {
-    size_t operator()(const Person& person) const {
-        const size_t coef = 39'916'801;
-        const hash<string> string_hasher;
-        const hash<int> int_hasher;
-        const hash<double> double_hasher;
-        const AddressHasher address_hasher;
-
-        return coef * coef * coef * string_hasher(person.name) +
-               coef * coef * int_hasher(person.height) +
-               coef * double_hasher(person.weight) +
-               address_hasher(person.address);
-    }
-};
-
-const vector<string> WORDS = {
-    "Kieran", "Jong", "Jisheng", "Vickie", "Adam", "Simon", "Lance",
-    "Everett", "Bryan", "Timothy", "Daren", "Emmett", "Edwin", "List",
-    "Sharon", "Trying", "Dan", "Saad", "Kamiya", "Nikolai", "Del",
-    "Casper", "Arthur", "Mac", "Rajesh", "Belinda", "Robin", "Lenora",
-    "Carisa", "Penny", "Sabrina", "Ofer", "Suzanne", "Pria", "Magnus",
-    "Ralph", "Cathrin", "Phill", "Alex", "Reinhard", "Marsh", "Tandy",
-    "Mongo", "Matthieu", "Sundaresan", "Piotr", "Ramneek", "Lynne", "Erwin",
-    "Edgar", "Srikanth", "Kimberly", "Jingbai", "Lui", "Jussi", "Wilmer",
-    "Stuart", "Grant", "Hotta", "Stan", "Samir", "Ramadoss", "Narendra",
-    "Gill", "Jeff", "Raul", "Ken", "Rahul", "Max", "Agatha",
-    "Elizabeth", "Tai", "Ellen", "Matt", "Ian", "Toerless", "Naomi",
-    "Rodent", "Terrance", "Ethan", "Florian", "Rik", "Stanislaw", "Mott",
-    "Charlie", "Marguerite", "Hitoshi", "Panacea", "Dieter", "Randell", "Earle",
-    "Rajiv", "Ted", "Mann", "Bobbie", "Pat", "Olivier", "Harmon",
-    "Raman", "Justin"
-};
-
 void TestSmoke() {
     unordered_set<Person, PersonHasher> people;
     people.insert({"John Doe", 180, 75.5, {"New York", "5th Avenue", 10}});
@@ -110,10 +50,176 @@ void TestDistribution() {
     Assert(hashes.size() > 900, "Hash distribution is uniform");
 }
 
+void TestHeterogeneousLookup() {
+    PersonSet people;
+    people.insert({"John Doe", 180, 75.5, {"New York", "5th Avenue", 10}});
+    people.insert({"Jane Smith", 165, 60.0, {"Los Angeles", "Main Street", 20}});
+
+    const char raw[] = "John Doe|New York|5th Avenue";
+    const string_view buffer(raw);
+    PersonView john{buffer.substr(0, 8), 180, 75.5, {buffer.substr(9, 8), buffer.substr(18), 10}};
+    PersonView stranger{"John Doe", 181, 75.5, {"New York", "5th Avenue", 10}};
+
+    PersonHasher hasher;
+    AssertEqual(hasher(john), hasher(*people.find(john)), "View hashes like Person");
+    Assert(people.contains(john), "Found by view");
+    Assert(!people.contains(stranger), "Different height is not found");
+    Assert(Contains(people, john), "Contains helper works with std container");
+}
+
+void TestPersonTable() {
+    const vector<Person> people = GeneratePeople(1001);
+    PersonTable table(people.begin(), people.end());
+    AssertEqual(table.Size(), people.size(), "Table size");
+    Assert(table.Get(500) == people[500], "Row round-trips to Person");
+
+    const string& city = people[7].address.city;
+    Selection selection = table.SelectHeight(Compare::Greater, 180) & table.SelectCity(city);
+    selection |= table.SelectWeight(Compare::Less, 50.0);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < people.size(); ++i) {
+        const bool match = (people[i].height > 180 && people[i].address.city == city) || people[i].weight < 50.0;
+        expected += match;
+        AssertEqual(selection.Test(i), match, "Row " + to_string(i));
+    }
+    AssertEqual(selection.Count(), expected, "Selected count");
+
+    AssertEqual(table.SelectCity("Atlantis").Count(), 0u, "Unknown city selects nothing");
+    AssertEqual(table.SelectBuilding(Compare::Equal, people[3].address.building).Test(3), true, "Equal scan");
+}
+
+void TestHashStats() {
+    const vector<Person> people = GeneratePeopleWithDuplicates(2000, 0.5);
+    AssertEqual(people.size(), 2000u, "Dataset size");
+
+    auto flipper = [](const Person& person, auto callback) {
+        ForEachBitFlip(person, callback);
+    };
+    const HashReport report = AnalyzeHasher(people, PersonHasher{}, flipper, {1.0, 4.0});
+
+    Assert(report.unique_keys <= 1000u, "Half of the keys are duplicates");
+    Assert(report.keys_per_second > 0, "Throughput is measured");
+    AssertEqual(report.buckets.size(), 2u, "One bucket report per load factor");
+    for (const BucketStats& stats : report.buckets) {
+        size_t buckets = 0;
+        size_t elements = 0;
+        for (size_t size = 0; size < stats.histogram.size(); ++size) {
+            buckets += stats.histogram[size];
+            elements += size * stats.histogram[size];
+        }
+        AssertEqual(buckets, stats.bucket_count, "Histogram covers every bucket");
+        AssertEqual(elements, report.unique_keys, "Histogram covers every key");
+        AssertEqual(stats.longest_chain + 1, stats.histogram.size(), "Longest chain is the last histogram entry");
+    }
+    Assert(report.avalanche.samples > 0, "Avalanche samples collected");
+    Assert(report.avalanche.mean_flip_ratio > 0.2 && report.avalanche.mean_flip_ratio < 0.8, "Bit flips spread over the hash");
+}
+
+void TestConcurrentSet() {
+    const vector<Person> people = GeneratePeopleWithDuplicates(4000, 0.5);
+    const size_t unique_count = PersonSet(people.begin(), people.end()).size();
+
+    ConcurrentPersonSet set(16);
+    vector<thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; i < people.size(); i += 4) {
+                set.Insert(people[i]);
+            }
+        });
+    }
+    for (thread& th : threads) {
+        th.join();
+    }
+    AssertEqual(set.Size(), unique_count, "Concurrent inserts deduplicate");
+    Assert(set.Contains(people[10]), "Contains by Person");
+    Assert(set.Contains(MakeView(people[20])), "Contains by PersonView");
+
+    ConcurrentPersonSet bulk(8);
+    AssertEqual(bulk.BulkInsert(people, 3), unique_count, "Bulk insert reports new elements");
+    AssertEqual(bulk.BulkInsert(people, 3), 0u, "Second bulk insert adds nothing");
+    AssertEqual(bulk.Size(), unique_count, "Bulk insert deduplicates");
+
+    ConcurrentPersonSet single(0);
+    AssertEqual(single.BulkInsert(people, 2), unique_count, "Zero shards fall back to one");
+    Assert(single.Contains(people[0]), "Contains with a single shard");
+}
+
+void TestSnapshot() {
+    const vector<Person> people = GeneratePeopleWithDuplicates(500, 0.2);
+    const PersonSet original(people.begin(), people.end());
+
+    ostringstream output;
+    SaveSnapshot(original, output);
+    const string data = output.str();
+
+    SnapshotView snapshot(data);
+    AssertEqual(snapshot.Size(), original.size(), "Snapshot size");
+    for (const Person& person : original) {
+        Assert(snapshot.Contains(MakeView(person)), "Snapshot contains " + person.name);
+    }
+    Person stranger = people.front();
+    stranger.height += 1000;
+    Assert(!snapshot.Contains(MakeView(stranger)), "Snapshot does not contain stranger");
+
+    size_t hashes_match = 0;
+    snapshot.ForEach([&](const PersonView& person, size_t hash) {
+        hashes_match += hash == PersonHasher{}(person);
+    });
+    AssertEqual(hashes_match, original.size(), "Stored hashes are precomputed PersonHasher values");
+    const HashedPersonSet reloaded = LoadPersonSet(snapshot);
+    AssertEqual(reloaded.size(), original.size(), "Reloaded set size");
+    for (const Person& person : original) {
+        Assert(Contains(reloaded, MakeView(person)), "Reloaded set contains " + person.name);
+        Assert(reloaded.count(person) == 1, "Reloaded set finds Person");
+    }
+    for (const HashedPerson& entry : reloaded) {
+        Assert(entry.hash == PersonHasher{}(entry.person), "Reloaded hash is the stored PersonHasher value");
+    }
+    Assert(!Contains(reloaded, MakeView(stranger)), "Reloaded set does not contain stranger");
+
+    const string path = "test_people.snapshot";
+    {
+        ofstream file(path, ios::binary);
+        file << data;
+    }
+    {
+        MappedFile file(path);
+        const HashedPersonSet mapped = LoadPersonSet(SnapshotView(file.Data()));
+        AssertEqual(mapped.size(), original.size(), "Mapped snapshot reloads");
+        Assert(Contains(mapped, MakeView(people.back())), "Mapped snapshot contains a person");
+    }
+    remove(path.c_str());
+
+    try {
+        SnapshotView broken(string_view(data).substr(0, 10));
+        Assert(false, "Truncated snapshot must be rejected");
+    } catch (const invalid_argument&) {
+    }
+
+    // Індекс без порожніх слотів: Contains зациклився б
+    string full = data;
+    Snapshot::Header header;
+    memcpy(&header, full.data(), sizeof(header));
+    header.count = header.index_slots;
+    memcpy(full.data(), &header, sizeof(header));
+    try {
+        SnapshotView broken(full);
+        Assert(false, "Index without empty slots must be rejected");
+    } catch (const invalid_argument&) {
+    }
+}
+
 int main() {
     TestRunner tr;
     tr.RunTest(TestSmoke, "TestSmoke");
     tr.RunTest(TestPurity, "TestPurity");
     tr.RunTest(TestDistribution, "TestDistribution");
+    tr.RunTest(TestHeterogeneousLookup, "TestHeterogeneousLookup");
+    tr.RunTest(TestPersonTable, "TestPersonTable");
+    tr.RunTest(TestHashStats, "TestHashStats");
+    tr.RunTest(TestConcurrentSet, "TestConcurrentSet");
+    tr.RunTest(TestSnapshot, "TestSnapshot");
     return 0;
 }
\ No newline at end of file
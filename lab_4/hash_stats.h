@@ -0,0 +1,220 @@
+#ifndef HASH_STATS_H
+#define HASH_STATS_H
+
+#include "person.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <unordered_set>
+#include <vector>
+
+// Заповненість кошиків unordered_set при заданому max_load_factor
+struct BucketStats {
+    double max_load_factor = 0;
+    double load_factor = 0;
+    size_t bucket_count = 0;
+    size_t longest_chain = 0;
+    double average_probe = 0;        // середня кількість порівнянь при успішному пошуку
+    std::vector<size_t> histogram;   // histogram[k] - кількість кошиків з k елементами
+};
+
+// Лавинний ефект: як часто змінюються біти хешу при зміні одного біта ключа
+struct AvalancheStats {
+    size_t samples = 0;
+    double mean_flip_ratio = 0;      // ідеал 0.5
+    double worst_bit_bias = 0;       // max |P(біт виходу змінився) - 0.5|
+};
+
+struct HashReport {
+    size_t keys = 0;
+    size_t unique_keys = 0;
+    double keys_per_second = 0;
+    double lookup_ns = 0;
+    std::vector<BucketStats> buckets;
+    AvalancheStats avalanche;
+};
+
+template <typename T, typename Hasher>
+double MeasureThroughput(const std::vector<T>& keys, const Hasher& hasher, int rounds = 10) {
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const T& key : keys) {
+            sink ^= hasher(key);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // sink не дає компілятору викинути цикл
+    volatile size_t keep = sink;
+    (void)keep;
+    return keys.size() * rounds / elapsed.count();
+}
+
+// Середній час успішного find у наносекундах
+template <typename T, typename Hasher, typename Equal = std::equal_to<T>>
+double MeasureLookup(const std::vector<T>& keys, const Hasher& hasher, int rounds = 5) {
+    std::unordered_set<T, Hasher, Equal> set(keys.begin(), keys.end(), 0, hasher);
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const T& key : keys) {
+            found += set.count(key);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    volatile size_t keep = found;
+    (void)keep;
+    return elapsed.count() / (keys.size() * rounds);
+}
+
+template <typename T, typename Hasher, typename Equal = std::equal_to<T>>
+BucketStats CollectBucketStats(const std::vector<T>& keys, const Hasher& hasher, double max_load_factor) {
+    std::unordered_set<T, Hasher, Equal> set(keys.begin(), keys.end(), 0, hasher);
+    set.max_load_factor(max_load_factor);
+    set.rehash(static_cast<size_t>(std::ceil(set.size() / max_load_factor)));
+
+    BucketStats stats;
+    stats.max_load_factor = max_load_factor;
+    stats.load_factor = set.load_factor();
+    stats.bucket_count = set.bucket_count();
+
+    size_t comparisons = 0;
+    for (size_t bucket = 0; bucket < set.bucket_count(); ++bucket) {
+        const size_t size = set.bucket_size(bucket);
+        if (stats.histogram.size() <= size) {
+            stats.histogram.resize(size + 1);
+        }
+        ++stats.histogram[size];
+        stats.longest_chain = std::max(stats.longest_chain, size);
+        // Пошук k-го елемента ланцюжка робить k порівнянь
+        comparisons += size * (size + 1) / 2;
+    }
+    stats.average_probe = set.empty() ? 0 : static_cast<double>(comparisons) / set.size();
+    return stats;
+}
+
+// flipper(key, callback) має викликати callback для кожної копії key з одним зміненим бітом
+template <typename T, typename Hasher, typename Flipper>
+AvalancheStats MeasureAvalanche(const std::vector<T>& keys, const Hasher& hasher, Flipper flipper,
+                                size_t max_keys = 1000) {
+    constexpr size_t BITS = sizeof(size_t) * 8;
+    std::array<size_t, BITS> flips_per_bit{};
+    size_t flipped_bits = 0;
+
+    AvalancheStats stats;
+    for (size_t i = 0; i < keys.size() && i < max_keys; ++i) {
+        const size_t original = hasher(keys[i]);
+        flipper(keys[i], [&](const T& mutated) {
+            const size_t diff = original ^ hasher(mutated);
+            flipped_bits += __builtin_popcountll(diff);
+            for (size_t bit = 0; bit < BITS; ++bit) {
+                flips_per_bit[bit] += (diff >> bit) & 1;
+            }
+            ++stats.samples;
+        });
+    }
+
+    if (stats.samples > 0) {
+        stats.mean_flip_ratio = static_cast<double>(flipped_bits) / (stats.samples * BITS);
+        for (size_t flips : flips_per_bit) {
+            const double bias = std::abs(static_cast<double>(flips) / stats.samples - 0.5);
+            stats.worst_bit_bias = std::max(stats.worst_bit_bias, bias);
+        }
+    }
+    return stats;
+}
+
+template <typename T, typename Hasher, typename Flipper, typename Equal = std::equal_to<T>>
+HashReport AnalyzeHasher(const std::vector<T>& keys, const Hasher& hasher, Flipper flipper,
+                         const std::vector<double>& load_factors = {0.5, 1.0, 2.0}) {
+    HashReport report;
+    report.keys = keys.size();
+    report.unique_keys = std::unordered_set<T, Hasher, Equal>(keys.begin(), keys.end(), 0, hasher).size();
+    report.keys_per_second = MeasureThroughput(keys, hasher);
+    report.lookup_ns = MeasureLookup<T, Hasher, Equal>(keys, hasher);
+    for (double load_factor : load_factors) {
+        report.buckets.push_back(CollectBucketStats<T, Hasher, Equal>(keys, hasher, load_factor));
+    }
+    report.avalanche = MeasureAvalanche(keys, hasher, flipper);
+    return report;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const HashReport& report) {
+    os << std::fixed << std::setprecision(3);
+    os << "keys: " << report.keys << " (unique " << report.unique_keys << ")\n";
+    os << "throughput: " << report.keys_per_second / 1e6 << " Mkeys/s\n";
+    os << "lookup: " << report.lookup_ns << " ns\n";
+    for (const BucketStats& stats : report.buckets) {
+        os << "max load " << stats.max_load_factor
+           << ": load " << stats.load_factor
+           << ", buckets " << stats.bucket_count
+           << ", longest chain " << stats.longest_chain
+           << ", average probe " << stats.average_probe
+           << ", histogram [";
+        for (size_t size = 0; size < stats.histogram.size(); ++size) {
+            os << (size ? ", " : "") << size << ": " << stats.histogram[size];
+        }
+        os << "]\n";
+    }
+    os << "avalanche: mean " << report.avalanche.mean_flip_ratio
+       << ", worst bit bias " << report.avalanche.worst_bit_bias
+       << " (" << report.avalanche.samples << " samples)\n";
+    return os;
+}
+
+template <typename Callback>
+void ForEachBitFlip(const std::string& text, Callback callback) {
+    std::string mutated = text;
+    for (size_t i = 0; i < mutated.size(); ++i) {
+        for (int bit = 0; bit < 8; ++bit) {
+            mutated[i] ^= static_cast<char>(1 << bit);
+            callback(mutated);
+            mutated[i] ^= static_cast<char>(1 << bit);
+        }
+    }
+}
+
+// Усі варіанти Person, що відрізняються рівно одним бітом одного з полів
+template <typename Callback>
+void ForEachBitFlip(const Person& person, Callback callback) {
+    Person mutated = person;
+    for (int bit = 0; bit < 32; ++bit) {
+        mutated.height ^= 1 << bit;
+        callback(mutated);
+        mutated.height = person.height;
+
+        mutated.address.building ^= 1 << bit;
+        callback(mutated);
+        mutated.address.building = person.address.building;
+    }
+    for (int bit = 0; bit < 64; ++bit) {
+        uint64_t raw;
+        std::memcpy(&raw, &person.weight, sizeof(raw));
+        raw ^= uint64_t(1) << bit;
+        std::memcpy(&mutated.weight, &raw, sizeof(raw));
+        callback(mutated);
+    }
+    mutated.weight = person.weight;
+
+    ForEachBitFlip(person.name, [&](const std::string& name) {
+        mutated.name = name;
+        callback(mutated);
+    });
+    mutated.name = person.name;
+    ForEachBitFlip(person.address.city, [&](const std::string& city) {
+        mutated.address.city = city;
+        callback(mutated);
+    });
+    mutated.address.city = person.address.city;
+    ForEachBitFlip(person.address.street, [&](const std::string& street) {
+        mutated.address.street = street;
+        callback(mutated);
+    });
+}
+
+#endif // HASH_STATS_H
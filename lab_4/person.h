@@ -0,0 +1,138 @@
+#ifndef PERSON_H
+#define PERSON_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+struct Address {
+    std::string city, street;
+    int building;
+
+    bool operator==(const Address& other) const {
+        return city == other.city &&
+               street == other.street &&
+               building == other.building;
+    }
+};
+
+struct Person {
+    std::string name;
+    int height;
+    double weight;
+    Address address;
+
+    bool operator==(const Person& other) const {
+        return name == other.name &&
+               height == other.height &&
+               weight == other.weight &&
+               address == other.address;
+    }
+};
+
+// Легке представлення адреси, що не володіє рядками
+struct AddressView {
+    std::string_view city, street;
+    int building;
+};
+
+// Легке представлення людини для пошуку без створення Person
+struct PersonView {
+    std::string_view name;
+    int height;
+    double weight;
+    AddressView address;
+};
+
+inline AddressView MakeView(const Address& address) {
+    return {address.city, address.street, address.building};
+}
+
+inline PersonView MakeView(const Person& person) {
+    return {person.name, person.height, person.weight, MakeView(person.address)};
+}
+
+inline bool operator==(const AddressView& lhs, const AddressView& rhs) {
+    return lhs.city == rhs.city &&
+           lhs.street == rhs.street &&
+           lhs.building == rhs.building;
+}
+
+inline bool operator==(const PersonView& lhs, const PersonView& rhs) {
+    return lhs.name == rhs.name &&
+           lhs.height == rhs.height &&
+           lhs.weight == rhs.weight &&
+           lhs.address == rhs.address;
+}
+
+// hash<string_view> збігається з hash<string>, тому хеш Person і PersonView однаковий
+struct AddressHasher {
+    using is_transparent = void;
+
+    size_t operator()(const AddressView& address) const {
+        const size_t coef = 514'229;
+        const std::hash<std::string_view> string_hasher;
+        const std::hash<int> int_hasher;
+
+        return coef * coef * string_hasher(address.city) +
+               coef * string_hasher(address.street) +
+               int_hasher(address.building);
+    }
+
+    size_t operator()(const Address& address) const {
+        return (*this)(MakeView(address));
+    }
+};
+
+struct PersonHasher {
+    using is_transparent = void;
+
+    size_t operator()(const PersonView& person) const {
+        const size_t coef = 39'916'801;
+        const std::hash<std::string_view> string_hasher;
+        const std::hash<int> int_hasher;
+        const std::hash<double> double_hasher;
+        const AddressHasher address_hasher;
+
+        return coef * coef * coef * string_hasher(person.name) +
+               coef * coef * int_hasher(person.height) +
+               coef * double_hasher(person.weight) +
+               address_hasher(person.address);
+    }
+
+    size_t operator()(const Person& person) const {
+        return (*this)(MakeView(person));
+    }
+};
+
+// Прозоре порівняння: дозволяє find/contains за PersonView
+struct PersonEqual {
+    using is_transparent = void;
+
+    bool operator()(const Person& lhs, const Person& rhs) const {
+        return lhs == rhs;
+    }
+
+    bool operator()(const Person& lhs, const PersonView& rhs) const {
+        return MakeView(lhs) == rhs;
+    }
+
+    bool operator()(const PersonView& lhs, const Person& rhs) const {
+        return lhs == MakeView(rhs);
+    }
+
+    bool operator()(const PersonView& lhs, const PersonView& rhs) const {
+        return lhs == rhs;
+    }
+};
+
+using PersonSet = std::unordered_set<Person, PersonHasher, PersonEqual>;
+
+// Перевірка належності для будь-якої множини з прозорими PersonHasher/PersonEqual
+template <typename Set>
+bool Contains(const Set& people, const PersonView& person) {
+    return people.find(person) != people.end();
+}
+
+#endif // PERSON_H
@@ -0,0 +1,63 @@
+#ifndef PERSON_GENERATOR_H
+#define PERSON_GENERATOR_H
+
+#include "person.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+inline const std::vector<std::string> WORDS = {
+    "Kieran", "Jong", "Jisheng", "Vickie", "Adam", "Simon", "Lance",
+    "Everett", "Bryan", "Timothy", "Daren", "Emmett", "Edwin", "List",
+    "Sharon", "Trying", "Dan", "Saad", "Kamiya", "Nikolai", "Del",
+    "Casper", "Arthur", "Mac", "Rajesh", "Belinda", "Robin", "Lenora",
+    "Carisa", "Penny", "Sabrina", "Ofer", "Suzanne", "Pria", "Magnus",
+    "Ralph", "Cathrin", "Phill", "Alex", "Reinhard", "Marsh", "Tandy",
+    "Mongo", "Matthieu", "Sundaresan", "Piotr", "Ramneek", "Lynne", "Erwin",
+    "Edgar", "Srikanth", "Kimberly", "Jingbai", "Lui", "Jussi", "Wilmer",
+    "Stuart", "Grant", "Hotta", "Stan", "Samir", "Ramadoss", "Narendra",
+    "Gill", "Jeff", "Raul", "Ken", "Rahul", "Max", "Agatha",
+    "Elizabeth", "Tai", "Ellen", "Matt", "Ian", "Toerless", "Naomi",
+    "Rodent", "Terrance", "Ethan", "Florian", "Rik", "Stanislaw", "Mott",
+    "Charlie", "Marguerite", "Hitoshi", "Panacea", "Dieter", "Randell", "Earle",
+    "Rajiv", "Ted", "Mann", "Bobbie", "Pat", "Olivier", "Harmon",
+    "Raman", "Justin"
+};
+
+// Генерує випадкових людей зі слів WORDS; однаковий seed дає однаковий набір
+inline std::vector<Person> GeneratePeople(size_t count, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<size_t> word(0, WORDS.size() - 1);
+    std::uniform_int_distribution<int> height(150, 210);
+    std::uniform_int_distribution<int> half_kilos(90, 240);
+    std::uniform_int_distribution<int> building(1, 100);
+
+    std::vector<Person> people;
+    people.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        people.push_back({
+            WORDS[word(gen)] + " " + WORDS[word(gen)],
+            height(gen),
+            half_kilos(gen) / 2.0,
+            {WORDS[word(gen) % 20] + " City", WORDS[word(gen)] + " Street", building(gen)}
+        });
+    }
+    return people;
+}
+
+// Генерує count людей, з яких частка duplicate_share є повторами вже виданих
+inline std::vector<Person> GeneratePeopleWithDuplicates(size_t count, double duplicate_share, unsigned seed = 42) {
+    const size_t unique_count = std::max<size_t>(1, count - static_cast<size_t>(count * duplicate_share));
+    std::vector<Person> people = GeneratePeople(unique_count, seed);
+
+    std::mt19937 gen(seed + 1);
+    std::uniform_int_distribution<size_t> original(0, unique_count - 1);
+    while (people.size() < count) {
+        people.push_back(people[original(gen)]);
+    }
+    std::shuffle(people.begin(), people.end(), gen);
+    return people;
+}
+
+#endif // PERSON_GENERATOR_H
@@ -0,0 +1,333 @@
+#ifndef PERSON_SNAPSHOT_H
+#define PERSON_SNAPSHOT_H
+
+#include "person.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Бінарний знімок множини людей.
+//
+// [заголовок][записи][індекс]
+// Заголовок: "PSNP", версія, кількість записів, зміщення та розмір індексу.
+// Запис (вирівняний на 8 байт): готовий хеш, зріст, будинок, вага,
+// довжини рядків, потім байти імені, міста й вулиці.
+// Індекс: відкрита адресація з лінійним пробуванням, слот = {хеш, зміщення запису}.
+// Числа записані в порядку байтів машини, тож файл можна читати прямо через mmap.
+namespace Snapshot {
+
+constexpr char MAGIC[4] = {'P', 'S', 'N', 'P'};
+constexpr uint32_t VERSION = 1;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t index_offset;
+    uint64_t index_slots;
+};
+
+struct RecordHeader {
+    uint64_t hash;
+    int32_t height;
+    int32_t building;
+    double weight;
+    uint32_t name_size;
+    uint32_t city_size;
+    uint32_t street_size;
+    uint32_t reserved;
+};
+
+struct IndexSlot {
+    uint64_t hash;
+    uint64_t offset;   // 0 - порожній слот
+};
+
+inline size_t AlignUp(size_t value) {
+    return (value + 7) & ~size_t(7);
+}
+
+template <typename T>
+void WritePod(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace Snapshot
+
+// Записує будь-який контейнер Person у потік одним блоком
+template <typename Container>
+void SaveSnapshot(const Container& people, std::ostream& output) {
+    using namespace Snapshot;
+    const PersonHasher hasher;
+
+    std::string buffer(sizeof(Header), '\0');
+    std::vector<IndexSlot> entries;
+    for (const Person& person : people) {
+        const size_t offset = buffer.size();
+        const size_t hash = hasher(person);
+        entries.push_back({hash, offset});
+
+        RecordHeader record{
+            hash, person.height, person.address.building, person.weight,
+            static_cast<uint32_t>(person.name.size()),
+            static_cast<uint32_t>(person.address.city.size()),
+            static_cast<uint32_t>(person.address.street.size()),
+            0
+        };
+        WritePod(buffer, record);
+        buffer += person.name;
+        buffer += person.address.city;
+        buffer += person.address.street;
+        buffer.resize(AlignUp(buffer.size()), '\0');
+    }
+
+    size_t slots = 16;
+    while (slots < entries.size() * 2) {
+        slots *= 2;
+    }
+    std::vector<IndexSlot> index(slots, IndexSlot{0, 0});
+    for (const IndexSlot& entry : entries) {
+        size_t slot = entry.hash & (slots - 1);
+        while (index[slot].offset != 0) {
+            slot = (slot + 1) & (slots - 1);
+        }
+        index[slot] = entry;
+    }
+
+    Header header{{}, VERSION, entries.size(), buffer.size(), slots};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    buffer.append(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexSlot));
+
+    output.write(buffer.data(), buffer.size());
+}
+
+// Перегляд знімка без копіювання: записи розбираються лише при зверненні,
+// а пошук іде через збережений індекс без перерахунку хешів
+class SnapshotView {
+public:
+    explicit SnapshotView(std::string_view data) : data(data) {
+        using namespace Snapshot;
+        if (data.size() < sizeof(Header)) {
+            throw std::invalid_argument("Snapshot is too short");
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+            throw std::invalid_argument("Not a person snapshot");
+        }
+        // Без жодного порожнього слота пошук відсутнього запису не зупинився б
+        if (header.index_slots == 0 || (header.index_slots & (header.index_slots - 1)) != 0 ||
+            header.count >= header.index_slots ||
+            header.index_offset > data.size() ||
+            (data.size() - header.index_offset) / sizeof(IndexSlot) < header.index_slots) {
+            throw std::invalid_argument("Corrupted snapshot index");
+        }
+    }
+
+    size_t Size() const {
+        return header.count;
+    }
+
+    // Викликає callback(PersonView, hash) для кожного запису
+    template <typename Callback>
+    void ForEach(Callback callback) const {
+        size_t offset = sizeof(Snapshot::Header);
+        for (size_t i = 0; i < header.count; ++i) {
+            size_t hash;
+            const PersonView person = ReadRecord(offset, hash, offset);
+            callback(person, hash);
+        }
+    }
+
+    bool Contains(const PersonView& person) const {
+        const size_t hash = PersonHasher{}(person);
+        const size_t mask = header.index_slots - 1;
+        // Пошкоджений індекс може не мати порожніх слотів, тож не більше одного кола
+        for (size_t step = 0, slot = hash & mask; step < header.index_slots; ++step, slot = (slot + 1) & mask) {
+            const Snapshot::IndexSlot entry = ReadSlot(slot);
+            if (entry.offset == 0) {
+                return false;
+            }
+            if (entry.hash == hash) {
+                size_t stored_hash, next;
+                if (ReadRecord(entry.offset, stored_hash, next) == person) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    Snapshot::IndexSlot ReadSlot(size_t slot) const {
+        Snapshot::IndexSlot entry;
+        std::memcpy(&entry, data.data() + header.index_offset + slot * sizeof(entry), sizeof(entry));
+        return entry;
+    }
+
+    PersonView ReadRecord(size_t offset, size_t& hash, size_t& next) const {
+        Snapshot::RecordHeader record;
+        if (offset + sizeof(record) > header.index_offset) {
+            throw std::out_of_range("Snapshot record is out of range");
+        }
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        const size_t strings = offset + sizeof(record);
+        next = Snapshot::AlignUp(strings + record.name_size + record.city_size + record.street_size);
+        if (next > header.index_offset) {
+            throw std::out_of_range("Snapshot record is out of range");
+        }
+
+        hash = record.hash;
+        const std::string_view name = data.substr(strings, record.name_size);
+        const std::string_view city = data.substr(strings + record.name_size, record.city_size);
+        const std::string_view street = data.substr(strings + record.name_size + record.city_size, record.street_size);
+        return {name, record.height, record.weight, {city, street, record.building}};
+    }
+
+    std::string_view data;
+    Snapshot::Header header;
+};
+
+// Person разом із уже порахованим значенням PersonHasher
+struct HashedPerson {
+    Person person;
+    size_t hash;
+};
+
+// Хеш елемента береться готовим; для пошуку за Person чи PersonView рахується
+// той самий PersonHasher, тож усі три види ключів потрапляють в один кошик
+struct StoredPersonHasher {
+    using is_transparent = void;
+
+    size_t operator()(const HashedPerson& person) const {
+        return person.hash;
+    }
+
+    size_t operator()(const PersonView& person) const {
+        return PersonHasher{}(person);
+    }
+
+    size_t operator()(const Person& person) const {
+        return PersonHasher{}(person);
+    }
+};
+
+struct HashedPersonEqual {
+    using is_transparent = void;
+
+    bool operator()(const HashedPerson& lhs, const HashedPerson& rhs) const {
+        return lhs.hash == rhs.hash && lhs.person == rhs.person;
+    }
+
+    bool operator()(const HashedPerson& lhs, const PersonView& rhs) const {
+        return MakeView(lhs.person) == rhs;
+    }
+
+    bool operator()(const PersonView& lhs, const HashedPerson& rhs) const {
+        return lhs == MakeView(rhs.person);
+    }
+
+    bool operator()(const HashedPerson& lhs, const Person& rhs) const {
+        return lhs.person == rhs;
+    }
+
+    bool operator()(const Person& lhs, const HashedPerson& rhs) const {
+        return lhs == rhs.person;
+    }
+};
+
+// Множина, що не хешує записи повторно ні при вставці, ні при рості таблиці
+using HashedPersonSet = std::unordered_set<HashedPerson, StoredPersonHasher, HashedPersonEqual>;
+
+// Відновлює множину зі знімка з уже збереженими хешами: PersonHasher для записів
+// не викликається, а кошики виділяються одразу на всі записи.
+// Збережений хеш має дорівнювати PersonHasher запису, інакше пошук його не знайде
+inline HashedPersonSet LoadPersonSet(const SnapshotView& snapshot) {
+    HashedPersonSet people;
+    people.reserve(snapshot.Size());
+    snapshot.ForEach([&](const PersonView& person, size_t hash) {
+        people.insert(HashedPerson{
+            Person{
+                std::string(person.name), person.height, person.weight,
+                {std::string(person.address.city), std::string(person.address.street), person.address.building}
+            },
+            hash
+        });
+    });
+    return people;
+}
+
+// Файл, відображений у пам'ять лише для читання; сторінки підвантажуються на вимогу.
+// Без POSIX файл просто читається цілком
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open file " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat file " + path);
+        }
+        size = info.st_size;
+        if (size > 0) {
+            void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not map file " + path);
+            }
+            mapped = static_cast<const char*>(address);
+        }
+        ::close(fd);
+#else
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("Could not open file " + path);
+        }
+        fallback.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        mapped = fallback.data();
+        size = fallback.size();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) {
+            ::munmap(const_cast<char*>(mapped), size);
+        }
+#endif
+    }
+
+    std::string_view Data() const {
+        return {mapped, size};
+    }
+
+private:
+    const char* mapped = nullptr;
+    size_t size = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+    std::string fallback;
+#endif
+};
+
+#endif // PERSON_SNAPSHOT_H
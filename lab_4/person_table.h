@@ -0,0 +1,267 @@
+#ifndef PERSON_TABLE_H
+#define PERSON_TABLE_H
+
+#include "person.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Бітова маска вибраних рядків таблиці: біт i відповідає рядку i
+class Selection {
+public:
+    explicit Selection(size_t size = 0) : words((size + 63) / 64), size(size) {}
+
+    size_t Size() const {
+        return size;
+    }
+
+    bool Test(size_t row) const {
+        return (words[row / 64] >> (row % 64)) & 1;
+    }
+
+    size_t Count() const {
+        size_t count = 0;
+        for (uint64_t word : words) {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    Selection& operator&=(const Selection& other) {
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] &= other.words[i];
+        }
+        return *this;
+    }
+
+    Selection& operator|=(const Selection& other) {
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    // Викликає callback(row) для кожного вибраного рядка
+    template <typename Callback>
+    void ForEach(Callback callback) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+                callback(i * 64 + __builtin_ctzll(word));
+            }
+        }
+    }
+
+private:
+    friend class PersonTable;
+
+    std::vector<uint64_t> words;
+    size_t size;
+};
+
+inline Selection operator&(Selection lhs, const Selection& rhs) {
+    return lhs &= rhs;
+}
+
+inline Selection operator|(Selection lhs, const Selection& rhs) {
+    return lhs |= rhs;
+}
+
+enum class Compare {
+    Less,
+    Equal,
+    Greater,
+};
+
+// Колонкове сховище людей: числові поля лежать у суцільних масивах,
+// а місто та вулиця закодовані словниковими ідентифікаторами
+class PersonTable {
+public:
+    using Id = int32_t;
+    static constexpr Id NO_ID = -1;
+
+    PersonTable() = default;
+
+    template <typename It>
+    PersonTable(It begin, It end) {
+        for (; begin != end; ++begin) {
+            Add(*begin);
+        }
+    }
+
+    void Add(const PersonView& person) {
+        names.emplace_back(person.name);
+        heights.push_back(person.height);
+        weights.push_back(person.weight);
+        city_ids.push_back(cities.Encode(person.address.city));
+        street_ids.push_back(streets.Encode(person.address.street));
+        buildings.push_back(person.address.building);
+    }
+
+    void Add(const Person& person) {
+        Add(MakeView(person));
+    }
+
+    size_t Size() const {
+        return heights.size();
+    }
+
+    Person Get(size_t row) const {
+        return {
+            names[row],
+            heights[row],
+            weights[row],
+            {cities.Decode(city_ids[row]), streets.Decode(street_ids[row]), buildings[row]}
+        };
+    }
+
+    Id FindCity(std::string_view city) const {
+        return cities.Find(city);
+    }
+
+    Id FindStreet(std::string_view street) const {
+        return streets.Find(street);
+    }
+
+    Selection SelectHeight(Compare op, int value) const {
+        return ScanInts(heights, op, value);
+    }
+
+    Selection SelectWeight(Compare op, double value) const {
+        return ScanDoubles(weights, op, value);
+    }
+
+    Selection SelectBuilding(Compare op, int value) const {
+        return ScanInts(buildings, op, value);
+    }
+
+    // Невідоме місто дає порожню вибірку, бо NO_ID не зустрічається в колонці
+    Selection SelectCity(std::string_view city) const {
+        return ScanInts(city_ids, Compare::Equal, FindCity(city));
+    }
+
+    Selection SelectStreet(std::string_view street) const {
+        return ScanInts(street_ids, Compare::Equal, FindStreet(street));
+    }
+
+private:
+    struct StringHasher {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    class Dictionary {
+    public:
+        Id Encode(std::string_view value) {
+            auto it = ids.find(value);
+            if (it != ids.end()) {
+                return it->second;
+            }
+            Id id = static_cast<Id>(values.size());
+            values.emplace_back(value);
+            ids.emplace(values.back(), id);
+            return id;
+        }
+
+        Id Find(std::string_view value) const {
+            auto it = ids.find(value);
+            return it == ids.end() ? NO_ID : it->second;
+        }
+
+        const std::string& Decode(Id id) const {
+            return values[id];
+        }
+
+    private:
+        std::vector<std::string> values;
+        std::unordered_map<std::string, Id, StringHasher, std::equal_to<>> ids;
+    };
+
+    template <typename T>
+    static bool Matches(T lhs, Compare op, T rhs) {
+        switch (op) {
+            case Compare::Less:
+                return lhs < rhs;
+            case Compare::Equal:
+                return lhs == rhs;
+            default:
+                return lhs > rhs;
+        }
+    }
+
+    // Хвіст, що не заповнює цілий SIMD-регістр, обробляється поелементно
+    template <typename T>
+    static void ScanTail(const std::vector<T>& column, size_t from, Compare op, T value, Selection& result) {
+        std::vector<uint64_t>& words = result.words;
+        for (size_t i = from; i < column.size(); ++i) {
+            words[i / 64] |= uint64_t(Matches(column[i], op, value)) << (i % 64);
+        }
+    }
+
+    static Selection ScanInts(const std::vector<int32_t>& column, Compare op, int32_t value) {
+        Selection result(column.size());
+        size_t i = 0;
+#ifdef __SSE2__
+        std::vector<uint64_t>& words = result.words;
+        const __m128i needle = _mm_set1_epi32(value);
+        for (; i + 4 <= column.size(); i += 4) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column.data() + i));
+            __m128i mask;
+            if (op == Compare::Less) {
+                mask = _mm_cmplt_epi32(chunk, needle);
+            } else if (op == Compare::Equal) {
+                mask = _mm_cmpeq_epi32(chunk, needle);
+            } else {
+                mask = _mm_cmpgt_epi32(chunk, needle);
+            }
+            const uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(mask));
+            words[i / 64] |= bits << (i % 64);
+        }
+#endif
+        ScanTail(column, i, op, value, result);
+        return result;
+    }
+
+    static Selection ScanDoubles(const std::vector<double>& column, Compare op, double value) {
+        Selection result(column.size());
+        size_t i = 0;
+#ifdef __SSE2__
+        std::vector<uint64_t>& words = result.words;
+        const __m128d needle = _mm_set1_pd(value);
+        for (; i + 2 <= column.size(); i += 2) {
+            const __m128d chunk = _mm_loadu_pd(column.data() + i);
+            __m128d mask;
+            if (op == Compare::Less) {
+                mask = _mm_cmplt_pd(chunk, needle);
+            } else if (op == Compare::Equal) {
+                mask = _mm_cmpeq_pd(chunk, needle);
+            } else {
+                mask = _mm_cmpgt_pd(chunk, needle);
+            }
+            const uint64_t bits = _mm_movemask_pd(mask);
+            words[i / 64] |= bits << (i % 64);
+        }
+#endif
+        ScanTail(column, i, op, value, result);
+        return result;
+    }
+
+    std::vector<std::string> names;
+    std::vector<int32_t> heights;
+    std::vector<double> weights;
+    std::vector<Id> city_ids;
+    std::vector<Id> street_ids;
+    std::vector<int32_t> buildings;
+    Dictionary cities;
+    Dictionary streets;
+};
+
+#endif // PERSON_TABLE_H
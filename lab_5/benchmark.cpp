@@ -0,0 +1,211 @@
+#include "json.h"
+#include "json_arena.h"
+#include "json_binary.h"
+#include "json_bind.h"
+#include "json_parallel.h"
+#include "json_pointer.h"
+#include "json_stream.h"
+#include "json_tape.h"
+#include "json_writer.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Record {
+    string category;
+    int amount;
+};
+
+JSON_SCHEMA(Record,
+    JSON_FIELD(Record, category),
+    JSON_FIELD(Record, amount)
+)
+
+// Масив витрат того ж вигляду, що й spendings.json
+string MakeSpendingsJson(size_t count) {
+    const vector<string> categories = {
+        "food", "transport", "restaurants", "clothes", "travel", "sport"
+    };
+    mt19937 gen(42);
+    uniform_int_distribution<int> amount(1, 30000);
+
+    string json = "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        json += "  {\"amount\": " + to_string(amount(gen)) +
+                ", \"category\": \"" + categories[i % categories.size()] + "\"}";
+        json += i + 1 < count ? ",\n" : "\n";
+    }
+    return json + "]\n";
+}
+
+template <typename Func>
+void MeasureThroughput(const string& title, size_t bytes, Func func) {
+    auto start = chrono::steady_clock::now();
+    func();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cerr << title << ": " << bytes / elapsed.count() / (1 << 20) << " MB/s" << endl;
+}
+
+void BenchmarkLoad(const string& json) {
+    MeasureThroughput("Load(string_view)", json.size(), [&] {
+        Document doc = Load(string_view(json));
+    });
+    MeasureThroughput("Load(istream)", json.size(), [&] {
+        istringstream input(json);
+        Document doc = Load(input);
+    });
+}
+
+void BenchmarkTape(const string& json) {
+    for (auto [kernel, name] : {pair{Stage1Kernel::Scalar, "scalar"}, pair{Stage1Kernel::Sse2, "sse2"},
+                                pair{DetectStage1Kernel(), "detected"}}) {
+        MeasureThroughput(string("Stage 1 (") + name + ")", json.size(), [&, kernel = kernel] {
+            FindStructuralIndexes(json, kernel);
+        });
+    }
+    MeasureThroughput("TapeDocument", json.size(), [&] {
+        TapeDocument doc(json);
+    });
+    MeasureThroughput("LoadTape", json.size(), [&] {
+        Document doc = LoadTape(json);
+    });
+}
+
+void BenchmarkStream(const string& json) {
+    MeasureThroughput("ArrayStreamReader + Load per element", json.size(), [&] {
+        istringstream input(json);
+        ArrayStreamReader reader(input);
+        string_view element;
+        while (reader.Next(element)) {
+            Document doc = Load(element);
+        }
+    });
+}
+
+void BenchmarkArena(const string& json) {
+    MeasureThroughput("ArenaDocument", json.size(), [&] {
+        ArenaDocument doc(json);
+    });
+
+    // Багато дрібних документів: арена перевикористовується між розборами
+    const string small = MakeSpendingsJson(20);
+    const int rounds = 20000;
+    MeasureThroughput("Load x" + to_string(rounds) + " small documents", small.size() * rounds, [&] {
+        for (int i = 0; i < rounds; ++i) {
+            Document doc = Load(string_view(small));
+        }
+    });
+    MeasureThroughput("ArenaDocument::Parse x" + to_string(rounds) + " small documents", small.size() * rounds, [&] {
+        ArenaDocument doc;
+        for (int i = 0; i < rounds; ++i) {
+            doc.Parse(small);
+        }
+    });
+}
+
+void BenchmarkBinding(const string& json) {
+    MeasureThroughput("Load + AsMap().at() walk", json.size(), [&] {
+        Document doc = Load(string_view(json));
+        vector<Record> records;
+        for (const Node& node : doc.GetRoot().AsArray()) {
+            const auto& fields = node.AsMap();
+            records.push_back({fields.at("category").AsString(), fields.at("amount").AsInt()});
+        }
+    });
+    MeasureThroughput("DecodeJson<vector<Record>>", json.size(), [&] {
+        vector<Record> records = DecodeJson<vector<Record>>(json);
+    });
+}
+
+void BenchmarkParallel(const string& json) {
+    const size_t max_threads = max(4u, thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        MeasureThroughput("ParallelReduce sum, " + to_string(threads) + " threads", json.size(), [&] {
+            ParallelReduce<long long>(json, threads,
+                [](long long& total, JsonReader& reader) {
+                    static thread_local string scratch;
+                    Record record;
+                    DecodeValue(reader, record, scratch);
+                    total += record.amount;
+                },
+                [](long long& total, long long other) {
+                    total += other;
+                });
+        });
+    }
+}
+
+void BenchmarkSave(const string& json) {
+    const Document doc = Load(string_view(json));
+    MeasureThroughput("ostream << records", json.size(), [&] {
+        ostringstream output;
+        output << "[";
+        bool first = true;
+        for (const Node& node : doc.GetRoot().AsArray()) {
+            const auto& fields = node.AsMap();
+            output << (first ? "" : ",") << "{\"amount\":" << fields.at("amount").AsInt()
+                   << ",\"category\":\"" << fields.at("category").AsString() << "\"}";
+            first = false;
+        }
+        output << "]";
+    });
+    for (auto [format, name] : {pair{SaveFormat::Compact, "compact"}, pair{SaveFormat::Pretty, "pretty"}}) {
+        MeasureThroughput(string("Save (") + name + ")", json.size(), [&, format = format] {
+            string output;
+            StringWriter writer(output);
+            Save(doc, writer, format);
+        });
+    }
+}
+
+void BenchmarkPointer(const string& json, size_t count) {
+    const string last = "/" + to_string(count - 1) + "/amount";
+    for (const string& pointer : {string("/0/amount"), last}) {
+        MeasureThroughput("Load + index " + pointer, json.size(), [&] {
+            Document doc = Load(string_view(json));
+            const size_t index = pointer == last ? count - 1 : 0;
+            doc.GetRoot().AsArray()[index].AsMap().at("amount").AsInt();
+        });
+        MeasureThroughput("Find " + pointer, json.size(), [&] {
+            Find(json, pointer).AsInt();
+        });
+    }
+}
+
+void BenchmarkBinary(const string& json, size_t count) {
+    const string binary = EncodeBinary(Load(string_view(json)));
+    cerr << "Binary size: " << binary.size() / (1 <<20) << " MB" << endl;
+    MeasureThroughput("BinaryDocument + read every amount", json.size(), [&] {
+        const BinaryValue root = BinaryDocument(binary).GetRoot();
+        long long total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            total += root[i].At("amount").AsInt();
+        }
+    });
+    MeasureThroughput("DecodeBinary", json.size(), [&] {
+        Document doc = DecodeBinary(binary);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const string json = MakeSpendingsJson(count);
+    cerr << "Input: " << json.size() / (1 << 20) << " MB" << endl;
+
+    BenchmarkLoad(json);
+    BenchmarkTape(json);
+    BenchmarkStream(json);
+    BenchmarkArena(json);
+    BenchmarkBinding(json);
+    BenchmarkParallel(json);
+    BenchmarkSave(json);
+    BenchmarkPointer(json, count);
+    BenchmarkBinary(json, count);
+    return 0;
+}
@@ -1,24 +1,50 @@
 #pragma once
+#include <cstddef>
 #include <istream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
+#include <variant>
 
+// Вузол зберігає лише активну альтернативу; звернення до іншого типу
+// кидає std::bad_variant_access
 class Node {
 public:
+    // Порядок збігається з порядком альтернатив у value
+    enum class Type {
+        Array,
+        Map,
+        Int,
+        String,
+        Double,
+        Bool,
+        Null,
+    };
+
+    Node();
+
     explicit Node(std::vector<Node> array);
     explicit Node(std::map<std::string, Node> map);
     explicit Node(int value);
     explicit Node(std::string value);
+    // Без цього перевантаження рядковий літерал перетворився б на bool
+    explicit Node(const char* value);
+    explicit Node(double value);
+    explicit Node(bool value);
+    explicit Node(std::nullptr_t);
+    Type GetType() const;
     const std::vector<Node>& AsArray() const;
     const std::map<std::string, Node>& AsMap() const;
     int AsInt() const;
     const std::string& AsString() const;
+    // Для цілого вузла повертає його значення як double
+    double AsDouble() const;
+    bool AsBool() const;
+    bool IsNull() const;
 private:
-    std::vector<Node> as_array;
-    std::map<std::string, Node> as_map;
-    int as_int;
-    std::string as_string;
+    std::variant<std::vector<Node>, std::map<std::string, Node>, int, std::string,
+                 double, bool, std::nullptr_t> value;
 };
 
 class Document {
@@ -29,4 +55,6 @@ private:
     Node root;
 };
 
+// Розбирає повну граматику JSON; при помилці кидає ParsingError з позицією
+Document Load(std::string_view input);
 Document Load(std::istream& input);
@@ -0,0 +1,247 @@
+#include "json_arena.h"
+#include "json_reader.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+Node::Type ArenaNode::GetType() const {
+    return type;
+}
+
+void ArenaNode::Expect(Node::Type expected) const {
+    if (type != expected) {
+        throw std::logic_error("Unexpected arena node type");
+    }
+}
+
+int ArenaNode::AsInt() const {
+    Expect(Node::Type::Int);
+    return as_int;
+}
+
+double ArenaNode::AsDouble() const {
+    if (type == Node::Type::Int) {
+        return as_int;
+    }
+    Expect(Node::Type::Double);
+    return as_double;
+}
+
+bool ArenaNode::AsBool() const {
+    Expect(Node::Type::Bool);
+    return as_bool;
+}
+
+bool ArenaNode::IsNull() const {
+    return type == Node::Type::Null;
+}
+
+string_view ArenaNode::AsString() const {
+    Expect(Node::Type::String);
+    return {as_string, size};
+}
+
+size_t ArenaNode::Size() const {
+    if (type != Node::Type::Array && type != Node::Type::Map) {
+        throw std::logic_error("Arena node is not a container");
+    }
+    return size;
+}
+
+const ArenaNode& ArenaNode::operator[](size_t index) const {
+    Expect(Node::Type::Array);
+    if (index >= size) {
+        throw std::out_of_range("Array index is out of range");
+    }
+    return items[index];
+}
+
+const ArenaNode* ArenaNode::begin() const {
+    Expect(Node::Type::Array);
+    return items;
+}
+
+const ArenaNode* ArenaNode::end() const {
+    Expect(Node::Type::Array);
+    return items + size;
+}
+
+const ArenaNode::Member* ArenaNode::MembersBegin() const {
+    Expect(Node::Type::Map);
+    return members;
+}
+
+const ArenaNode::Member* ArenaNode::MembersEnd() const {
+    Expect(Node::Type::Map);
+    return members + size;
+}
+
+const ArenaNode* ArenaNode::Find(string_view key) const {
+    const Member* last = MembersEnd();
+    const Member* it = std::lower_bound(MembersBegin(), last, key,
+        [](const Member& member, string_view key) {
+            return member.key < key;
+        });
+    return it != last && it->key == key ? &it->value : nullptr;
+}
+
+const ArenaNode& ArenaNode::At(string_view key) const {
+    const ArenaNode* value = Find(key);
+    if (!value) {
+        throw std::out_of_range("Key not found: " + string(key));
+    }
+    return *value;
+}
+
+// Будує вузли, копіюючи дочірні елементи зі стеків в арену одним блоком
+class ArenaBuilder {
+public:
+    ArenaBuilder(std::pmr::memory_resource& arena, string_view text,
+                 vector<ArenaNode>& items, vector<ArenaNode::Member>& members)
+        : arena(arena)
+        , reader(text)
+        , items(items)
+        , members(members) {
+    }
+
+    ArenaNode Build() {
+        ArenaNode root = LoadNode();
+        if (!reader.AtEnd()) {
+            reader.Fail("Unexpected data after JSON value");
+        }
+        return root;
+    }
+
+private:
+    template <typename T>
+    T* Allocate(size_t count) {
+        return static_cast<T*>(arena.allocate(count * sizeof(T), alignof(T)));
+    }
+
+    string_view CopyString(string_view value) {
+        char* data = Allocate<char>(value.size());
+        std::memcpy(data, value.data(), value.size());
+        return {data, value.size()};
+    }
+
+    ArenaNode LoadArray() {
+        reader.Expect('[');
+        const size_t first = items.size();
+        if (!reader.Consume(']')) {
+            do {
+                ArenaNode item = LoadNode();
+                items.push_back(item);
+            } while (reader.Consume(','));
+            reader.Expect(']');
+        }
+
+        ArenaNode node;
+        node.type = Node::Type::Array;
+        node.size = static_cast<uint32_t>(items.size() - first);
+        ArenaNode* copy = Allocate<ArenaNode>(node.size);
+        std::copy(items.begin() + first, items.end(), copy);
+        node.items = copy;
+        items.resize(first);
+        return node;
+    }
+
+    ArenaNode LoadDict() {
+        reader.Expect('{');
+        const size_t first = members.size();
+        if (!reader.Consume('}')) {
+            do {
+                const string_view key = CopyString(reader.ReadString(scratch));
+                reader.Expect(':');
+                ArenaNode value = LoadNode();
+                members.push_back({key, value});
+            } while (reader.Consume(','));
+            reader.Expect('}');
+        }
+
+        // Як і в std::map, з однакових ключів лишається перший
+        auto begin = members.begin() + first;
+        std::stable_sort(begin, members.end(), [](const ArenaNode::Member& lhs, const ArenaNode::Member& rhs) {
+            return lhs.key < rhs.key;
+        });
+        auto last = std::unique(begin, members.end(), [](const ArenaNode::Member& lhs, const ArenaNode::Member& rhs) {
+            return lhs.key == rhs.key;
+        });
+
+        ArenaNode node;
+        node.type = Node::Type::Map;
+        node.size = static_cast<uint32_t>(last - begin);
+        ArenaNode::Member* copy = Allocate<ArenaNode::Member>(node.size);
+        std::copy(begin, last, copy);
+        node.members = copy;
+        members.resize(first);
+        return node;
+    }
+
+    ArenaNode LoadNode() {
+        ArenaNode node;
+        switch (reader.Peek()) {
+            case '[':
+                return LoadArray();
+            case '{':
+                return LoadDict();
+            case '"': {
+                const string_view value = CopyString(reader.ReadString(scratch));
+                node.type = Node::Type::String;
+                node.size = static_cast<uint32_t>(value.size());
+                node.as_string = value.data();
+                return node;
+            }
+            case 't':
+            case 'f':
+                node.type = Node::Type::Bool;
+                node.as_bool = reader.ReadBool();
+                return node;
+            case 'n':
+                reader.ReadNull();
+                node.type = Node::Type::Null;
+                return node;
+            default: {
+                const JsonNumber number = reader.ReadNumber();
+                if (number.is_int) {
+                    node.type = Node::Type::Int;
+                    node.as_int = number.as_int;
+                } else {
+                    node.type = Node::Type::Double;
+                    node.as_double = number.as_double;
+                }
+                return node;
+            }
+        }
+    }
+
+    std::pmr::memory_resource& arena;
+    JsonReader reader;
+    vector<ArenaNode>& items;
+    vector<ArenaNode::Member>& members;
+    string scratch;
+};
+
+ArenaDocument::ArenaDocument(size_t initial_arena_size)
+    : arena(std::make_unique<std::pmr::monotonic_buffer_resource>(initial_arena_size)) {
+}
+
+ArenaDocument::ArenaDocument(string_view text)
+    : arena(std::make_unique<std::pmr::monotonic_buffer_resource>(text.size() + 1)) {
+    Parse(text);
+}
+
+void ArenaDocument::Parse(string_view text) {
+    root = ArenaNode();
+    arena->release();
+    item_stack.clear();
+    member_stack.clear();
+    root = ArenaBuilder(*arena, text, item_stack, member_stack).Build();
+}
+
+const ArenaNode& ArenaDocument::GetRoot() const {
+    return root;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "json.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// Вузол документа в арені. Тривіально знищуваний: пам'ять звільняється
+// разом з усією ареною, без обходу дерева
+class ArenaNode {
+public:
+    struct Member;
+
+    Node::Type GetType() const;
+    int AsInt() const;
+    // Для цілого вузла повертає його значення як double
+    double AsDouble() const;
+    bool AsBool() const;
+    bool IsNull() const;
+    std::string_view AsString() const;
+
+    // Кількість елементів масиву або пар об'єкта
+    size_t Size() const;
+    const ArenaNode& operator[](size_t index) const;
+    const ArenaNode* begin() const;
+    const ArenaNode* end() const;
+
+    // Пари об'єкта відсортовані за ключем, пошук двійковий
+    const Member* MembersBegin() const;
+    const Member* MembersEnd() const;
+    const ArenaNode* Find(std::string_view key) const;
+    // Кидає std::out_of_range, якщо ключа немає
+    const ArenaNode& At(std::string_view key) const;
+
+private:
+    friend class ArenaBuilder;
+
+    void Expect(Node::Type expected) const;
+
+    Node::Type type = Node::Type::Null;
+    uint32_t size = 0;
+    union {
+        int as_int;
+        double as_double;
+        bool as_bool;
+        const char* as_string;
+        const ArenaNode* items = nullptr;
+        const Member* members;
+    };
+};
+
+struct ArenaNode::Member {
+    std::string_view key;
+    ArenaNode value;
+};
+
+// Документ, усі вузли, ключі та рядки якого лежать в одній монотонній арені.
+// Розбір не звертається до загальної купи, крім кількох стеків,
+// що перевикористовуються між викликами Parse
+class ArenaDocument {
+public:
+    explicit ArenaDocument(size_t initial_arena_size = 64 * 1024);
+    explicit ArenaDocument(std::string_view text);
+
+    // Звільняє попереднє дерево одним скиданням арени й розбирає text
+    void Parse(std::string_view text);
+    const ArenaNode& GetRoot() const;
+
+private:
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    ArenaNode root;
+    std::vector<ArenaNode> item_stack;
+    std::vector<ArenaNode::Member> member_stack;
+};
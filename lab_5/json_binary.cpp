@@ -0,0 +1,318 @@
+#include "json_binary.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+using std::map;
+using std::move;
+using std::string;
+using std::string_view;
+using std::vector;
+using namespace Binary;
+
+namespace {
+
+class Encoder {
+public:
+    string Encode(const Node& root) {
+        buffer.assign(sizeof(Header), '\0');
+        const Slot root_slot = EncodeValue(root, 0);
+        Header header{{}, VERSION, root_slot, CheckOffset(buffer.size()), 0};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        return move(buffer);
+    }
+
+private:
+    static uint32_t CheckOffset(size_t offset) {
+        if (offset > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Binary JSON document exceeds 4 GB");
+        }
+        return static_cast<uint32_t>(offset);
+    }
+
+    // Вирівнює кінець буфера і повертає зміщення нового блоку розміру size
+    size_t Allocate(size_t size, size_t alignment) {
+        const size_t offset = (buffer.size() + alignment - 1) & ~(alignment - 1);
+        buffer.resize(offset + size, '\0');
+        return offset;
+    }
+
+    template <typename T>
+    void Put(size_t offset, const T& value) {
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+    }
+
+    // Однакові рядки (насамперед ключі) записуються один раз
+    uint32_t EncodeString(string_view value) {
+        if (const auto it = strings.find(value); it != strings.end()) {
+            return it->second;
+        }
+        const size_t offset = Allocate(sizeof(uint32_t) + value.size(), alignof(uint32_t));
+        Put(offset, CheckOffset(value.size()));
+        std::memcpy(buffer.data() + offset + sizeof(uint32_t), value.data(), value.size());
+        strings.emplace(value, CheckOffset(offset));
+        return CheckOffset(offset);
+    }
+
+    Slot EncodeValue(const Node& node, size_t depth) {
+        if (depth > MAX_DEPTH) {
+            throw std::length_error("Binary JSON nesting is too deep");
+        }
+        const auto type = static_cast<uint32_t>(node.GetType());
+        switch (node.GetType()) {
+            case Node::Type::Int:
+                return {type, static_cast<uint32_t>(node.AsInt())};
+            case Node::Type::Bool:
+                return {type, node.AsBool()};
+            case Node::Type::Null:
+                return {type, 0};
+            case Node::Type::Double: {
+                const size_t offset = Allocate(sizeof(double), alignof(double));
+                Put(offset, node.AsDouble());
+                return {type, CheckOffset(offset)};
+            }
+            case Node::Type::String:
+                return {type, EncodeString(node.AsString())};
+            case Node::Type::Array: {
+                // Спершу місце під таблицю слотів, потім дані елементів
+                const vector<Node>& items = node.AsArray();
+                const size_t offset = Allocate(sizeof(uint64_t) + items.size() * sizeof(Slot), alignof(uint64_t));
+                Put(offset, static_cast<uint64_t>(items.size()));
+                for (size_t i = 0; i < items.size(); ++i) {
+                    const Slot item = EncodeValue(items[i], depth + 1);
+                    Put(offset + sizeof(uint64_t) + i * sizeof(Slot), item);
+                }
+                return {type, CheckOffset(offset)};
+            }
+            case Node::Type::Map: {
+                // std::map уже впорядкований за ключем
+                const map<string, Node>& members = node.AsMap();
+                const size_t offset = Allocate(sizeof(uint64_t) + members.size() * sizeof(Member), alignof(uint64_t));
+                Put(offset, static_cast<uint64_t>(members.size()));
+                size_t i = 0;
+                for (const auto& [key, value] : members) {
+                    const uint32_t key_offset = EncodeString(key) + sizeof(uint32_t);
+                    const Member member{key_offset, CheckOffset(key.size()), EncodeValue(value, depth + 1)};
+                    Put(offset + sizeof(uint64_t) + i++ * sizeof(Member), member);
+                }
+                return {type, CheckOffset(offset)};
+            }
+        }
+        throw std::logic_error("Unknown node type");
+    }
+
+    string buffer;
+    // Ключі вказують на рядки вихідного дерева, яке живе весь час кодування
+    std::unordered_map<string_view, uint32_t> strings;
+};
+
+}  // namespace
+
+string EncodeBinary(const Node& node) {
+    return Encoder().Encode(node);
+}
+
+string EncodeBinary(const Document& document) {
+    return EncodeBinary(document.GetRoot());
+}
+
+BinaryValue::BinaryValue(string_view data, Slot slot) : data(data), slot(slot) {
+}
+
+template <typename T>
+T BinaryValue::Read(size_t offset) const {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        throw std::out_of_range("Binary JSON value is out of range");
+    }
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+void BinaryValue::Expect(Node::Type type, const char* message) const {
+    if (GetType() != type) {
+        throw std::logic_error(message);
+    }
+}
+
+Node::Type BinaryValue::GetType() const {
+    if (slot.type > static_cast<uint32_t>(Node::Type::Null)) {
+        throw std::logic_error("Unknown binary JSON type");
+    }
+    return static_cast<Node::Type>(slot.type);
+}
+
+int BinaryValue::AsInt() const {
+    Expect(Node::Type::Int, "Binary value is not an int");
+    return static_cast<int>(slot.value);
+}
+
+double BinaryValue::AsDouble() const {
+    if (GetType() == Node::Type::Int) {
+        return AsInt();
+    }
+    Expect(Node::Type::Double, "Binary value is not a number");
+    return Read<double>(slot.value);
+}
+
+bool BinaryValue::AsBool() const {
+    Expect(Node::Type::Bool, "Binary value is not a bool");
+    return slot.value != 0;
+}
+
+bool BinaryValue::IsNull() const {
+    return GetType() == Node::Type::Null;
+}
+
+string_view BinaryValue::AsString() const {
+    Expect(Node::Type::String, "Binary value is not a string");
+    const uint32_t size = Read<uint32_t>(slot.value);
+    const size_t begin = slot.value + sizeof(uint32_t);
+    if (data.size() - begin < size) {
+        throw std::out_of_range("Binary JSON value is out of range");
+    }
+    return data.substr(begin, size);
+}
+
+size_t BinaryValue::Size() const {
+    if (GetType() != Node::Type::Array && GetType() != Node::Type::Map) {
+        throw std::logic_error("Binary value is not a container");
+    }
+    const uint64_t size = Read<uint64_t>(slot.value);
+    const size_t entry_size = GetType() == Node::Type::Array ? sizeof(Slot) : sizeof(Member);
+    // Пошкоджена кількість не повинна давати переповнення при обчисленні зміщень
+    if (size > data.size() / entry_size) {
+        throw std::out_of_range("Binary JSON value is out of range");
+    }
+    return size;
+}
+
+BinaryValue BinaryValue::operator[](size_t index) const {
+    Expect(Node::Type::Array, "Binary value is not an array");
+    if (index >= Size()) {
+        throw std::out_of_range("Array index is out of range");
+    }
+    return BinaryValue(data, Read<Slot>(slot.value + sizeof(uint64_t) + index * sizeof(Slot)));
+}
+
+Member BinaryValue::ReadMember(size_t index) const {
+    return Read<Member>(slot.value + sizeof(uint64_t) + index * sizeof(Member));
+}
+
+string_view BinaryValue::KeyAt(size_t index) const {
+    Expect(Node::Type::Map, "Binary value is not an object");
+    if (index >= Size()) {
+        throw std::out_of_range("Member index is out of range");
+    }
+    const Member member = ReadMember(index);
+    if (member.key_offset > data.size() || data.size() - member.key_offset < member.key_size) {
+        throw std::out_of_range("Binary JSON value is out of range");
+    }
+    return data.substr(member.key_offset, member.key_size);
+}
+
+BinaryValue BinaryValue::ValueAt(size_t index) const {
+    Expect(Node::Type::Map, "Binary value is not an object");
+    if (index >= Size()) {
+        throw std::out_of_range("Member index is out of range");
+    }
+    return BinaryValue(data, ReadMember(index).value);
+}
+
+bool BinaryValue::FindMember(string_view key, Slot& found) const {
+    Expect(Node::Type::Map, "Binary value is not an object");
+    size_t low = 0;
+    size_t high = Size();
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const int order = KeyAt(middle).compare(key);
+        if (order == 0) {
+            found = ReadMember(middle).value;
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+BinaryValue BinaryValue::At(string_view key) const {
+    Slot found;
+    if (!FindMember(key, found)) {
+        throw std::out_of_range("Key not found: " + string(key));
+    }
+    return BinaryValue(data, found);
+}
+
+bool BinaryValue::Contains(string_view key) const {
+    Slot found;
+    return FindMember(key, found);
+}
+
+Node BinaryValue::ToNode() const {
+    return ToNode(0);
+}
+
+Node BinaryValue::ToNode(size_t depth) const {
+    if (depth > MAX_DEPTH) {
+        throw std::out_of_range("Binary JSON nesting is too deep");
+    }
+    switch (GetType()) {
+        case Node::Type::Array: {
+            vector<Node> items;
+            const size_t size = Size();
+            items.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                items.push_back((*this)[i].ToNode(depth + 1));
+            }
+            return Node(move(items));
+        }
+        case Node::Type::Map: {
+            map<string, Node> members;
+            const size_t size = Size();
+            for (size_t i = 0; i < size; ++i) {
+                members.emplace_hint(members.end(), string(KeyAt(i)), ValueAt(i).ToNode(depth + 1));
+            }
+            return Node(move(members));
+        }
+        case Node::Type::Int:
+            return Node(AsInt());
+        case Node::Type::String:
+            return Node(string(AsString()));
+        case Node::Type::Double:
+            return Node(AsDouble());
+        case Node::Type::Bool:
+            return Node(AsBool());
+        case Node::Type::Null:
+            return Node(nullptr);
+    }
+    throw std::logic_error("Unknown binary JSON type");
+}
+
+BinaryDocument::BinaryDocument(string_view data) : data(data) {
+    Header header;
+    if (data.size() < sizeof(header)) {
+        throw std::invalid_argument("Binary JSON is too short");
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        throw std::invalid_argument("Not a binary JSON document");
+    }
+    if (header.size != data.size()) {
+        throw std::invalid_argument("Binary JSON size mismatch");
+    }
+    root = header.root;
+}
+
+BinaryValue BinaryDocument::GetRoot() const {
+    return BinaryValue(data, root);
+}
+
+Document DecodeBinary(string_view data) {
+    return Document(BinaryDocument(data).GetRoot().ToNode());
+}
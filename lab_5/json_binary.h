@@ -0,0 +1,101 @@
+#pragma once
+#include "json.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Бінарне представлення документа JSON для кешування: читається без розбору,
+// у тому числі прямо з файлу через MappedFile.
+//
+// [заголовок][дані]
+// Заголовок: "JBIN", версія, слот кореня, розмір усього буфера.
+// Слот (8 байт) = {тип, значення}: int і bool зберігаються прямо у слоті,
+// для double, рядків і контейнерів значення - зміщення їхніх даних.
+// Рядок: довжина, байти; однакові рядки зберігаються один раз. Масив: кількість, слоти елементів - індексація за O(1).
+// Об'єкт: кількість, записи {зміщення ключа, довжина ключа, слот значення},
+// відсортовані за ключем - пошук двійковий.
+// Числа записані в порядку байтів машини; зміщення 32-бітні, тож буфер до 4 ГБ.
+namespace Binary {
+
+constexpr char MAGIC[4] = {'J', 'B', 'I', 'N'};
+constexpr uint32_t VERSION = 1;
+// Найбільша вкладеність контейнерів: пошкоджена таблиця зміщень може
+// посилатися на батьківський слот, і без межі ToNode переповнив би стек
+constexpr size_t MAX_DEPTH = 1024;
+
+struct Slot {
+    uint32_t type;    // Node::Type
+    uint32_t value;
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    Slot root;
+    uint32_t size;
+    uint32_t reserved;
+};
+
+struct Member {
+    uint32_t key_offset;
+    uint32_t key_size;
+    Slot value;
+};
+
+}  // namespace Binary
+
+std::string EncodeBinary(const Node& node);
+std::string EncodeBinary(const Document& document);
+
+class BinaryDocument;
+
+// Перегляд значення в бінарному буфері з тими ж методами, що й Node.
+// Звернення до іншого типу кидає std::logic_error, вихід за межі буфера - std::out_of_range
+class BinaryValue {
+public:
+    Node::Type GetType() const;
+    int AsInt() const;
+    double AsDouble() const;
+    bool AsBool() const;
+    bool IsNull() const;
+    std::string_view AsString() const;
+
+    // Кількість елементів масиву або пар об'єкта
+    size_t Size() const;
+    BinaryValue operator[](size_t index) const;
+    // Двійковий пошук ключа; кидає std::out_of_range
+    BinaryValue At(std::string_view key) const;
+    bool Contains(std::string_view key) const;
+    // Ключ і значення пари з номером index у порядку зростання ключів
+    std::string_view KeyAt(size_t index) const;
+    BinaryValue ValueAt(size_t index) const;
+
+    // Глибша за Binary::MAX_DEPTH вкладеність кидає std::out_of_range
+    Node ToNode() const;
+
+private:
+    friend class BinaryDocument;
+    BinaryValue(std::string_view data, Binary::Slot slot);
+
+    void Expect(Node::Type type, const char* message) const;
+    template <typename T>
+    T Read(size_t offset) const;
+    Binary::Member ReadMember(size_t index) const;
+    bool FindMember(std::string_view key, Binary::Slot& slot) const;
+    Node ToNode(size_t depth) const;
+
+    std::string_view data;
+    Binary::Slot slot;
+};
+
+// Перевіряє заголовок; буфер має жити, доки використовуються значення
+class BinaryDocument {
+public:
+    explicit BinaryDocument(std::string_view data);
+    BinaryValue GetRoot() const;
+private:
+    std::string_view data;
+    Binary::Slot root;
+};
+
+Document DecodeBinary(std::string_view data);
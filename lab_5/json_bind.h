@@ -0,0 +1,124 @@
+#pragma once
+#include "json_reader.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Прив'язка JSON до структур C++ без проміжного дерева Node.
+// Поля структури описуються один раз:
+//
+//     JSON_SCHEMA(Spending,
+//         JSON_FIELD(Spending, category),
+//         JSON_FIELD(Spending, amount)
+//     )
+//
+// Хеші назв полів обчислюються під час компіляції; ключ з тексту
+// хешується один раз і порівнюється з ними, рядок - лише при збігу хешу.
+
+// FNV-1a
+constexpr uint64_t HashKey(std::string_view key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template <typename T>
+struct FieldBinding {
+    std::string_view name;
+    uint64_t hash;
+    void (*decode)(JsonReader& reader, T& object, std::string& scratch);
+};
+
+// Спеціалізується макросом JSON_SCHEMA
+template <typename T>
+struct JsonSchema;
+
+inline void DecodeValue(JsonReader& reader, int& value, std::string&) {
+    const JsonNumber number = reader.ReadNumber();
+    if (!number.is_int) {
+        reader.Fail("Expected an integer");
+    }
+    value = number.as_int;
+}
+
+inline void DecodeValue(JsonReader& reader, double& value, std::string&) {
+    value = reader.ReadNumber().as_double;
+}
+
+inline void DecodeValue(JsonReader& reader, bool& value, std::string&) {
+    value = reader.ReadBool();
+}
+
+inline void DecodeValue(JsonReader& reader, std::string& value, std::string& scratch) {
+    value = reader.ReadString(scratch);
+}
+
+template <typename T>
+void DecodeValue(JsonReader& reader, std::vector<T>& values, std::string& scratch) {
+    values.clear();
+    reader.Expect('[');
+    if (reader.Consume(']')) {
+        return;
+    }
+    do {
+        values.emplace_back();
+        DecodeValue(reader, values.back(), scratch);
+    } while (reader.Consume(','));
+    reader.Expect(']');
+}
+
+// Об'єкт зі схемою: невідомі ключі пропускаються, відсутні поля лишаються як є
+template <typename T, typename = decltype(JsonSchema<T>::fields)>
+void DecodeValue(JsonReader& reader, T& object, std::string& scratch) {
+    reader.Expect('{');
+    if (reader.Consume('}')) {
+        return;
+    }
+    do {
+        const std::string_view key = reader.ReadString(scratch);
+        const uint64_t hash = HashKey(key);
+        const FieldBinding<T>* field = nullptr;
+        for (const FieldBinding<T>& candidate : JsonSchema<T>::fields) {
+            if (candidate.hash == hash && candidate.name == key) {
+                field = &candidate;
+                break;
+            }
+        }
+        reader.Expect(':');
+        if (field) {
+            field->decode(reader, object, scratch);
+        } else {
+            reader.SkipValue();
+        }
+    } while (reader.Consume(','));
+    reader.Expect('}');
+}
+
+// Декодує весь текст у значення типу T; зайві дані після значення - помилка
+template <typename T>
+T DecodeJson(std::string_view text) {
+    JsonReader reader(text);
+    std::string scratch;
+    T value{};
+    DecodeValue(reader, value, scratch);
+    if (!reader.AtEnd()) {
+        reader.Fail("Unexpected data after JSON value");
+    }
+    return value;
+}
+
+#define JSON_FIELD(Type, member)                                                    \
+    FieldBinding<Type>{#member, HashKey(#member),                                   \
+        [](JsonReader& reader, Type& object, std::string& scratch) {                \
+            DecodeValue(reader, object.member, scratch);                            \
+        }}
+
+#define JSON_SCHEMA(Type, ...)                                                      \
+    template <>                                                                     \
+    struct JsonSchema<Type> {                                                       \
+        static constexpr FieldBinding<Type> fields[] = {__VA_ARGS__};               \
+    };
@@ -0,0 +1,128 @@
+#include "json_parallel.h"
+#include <algorithm>
+
+using std::string_view;
+using std::vector;
+
+namespace {
+
+// Підсумок діапазону для обох припущень про стан на його початку
+struct RangeSummary {
+    bool odd_quotes = false;
+    long depth_outside = 0;   // зміна глибини, якщо діапазон починається поза рядком
+    long depth_inside = 0;    // ... і якщо всередині рядка
+};
+
+// Непарна кількість зворотних скісних перед pos означає, що text[pos] екранований
+bool IsEscaped(string_view text, size_t pos) {
+    size_t backslashes = 0;
+    while (pos > backslashes && text[pos - backslashes - 1] == '\\') {
+        ++backslashes;
+    }
+    return backslashes % 2 == 1;
+}
+
+RangeSummary SummarizeRange(string_view text, size_t begin, size_t end) {
+    RangeSummary summary;
+    // Стан "в рядку" для припущення, що діапазон починається поза рядком
+    bool in_string = false;
+    for (size_t i = IsEscaped(text, begin) ? begin + 1 : begin; i < end; ++i) {
+        switch (text[i]) {
+            case '\\':
+                // Поза рядком зворотна скісна - помилка, яку знайде розбір шматка
+                ++i;
+                break;
+            case '"':
+                in_string = !in_string;
+                break;
+            case '[':
+            case '{':
+                ++(in_string ? summary.depth_inside : summary.depth_outside);
+                break;
+            case ']':
+            case '}':
+                --(in_string ? summary.depth_inside : summary.depth_outside);
+                break;
+        }
+    }
+    summary.odd_quotes = in_string;
+    return summary;
+}
+
+// Перша кома верхнього рівня в [begin, end) при відомому стані на begin
+size_t FindBoundary(string_view text, size_t begin, size_t end, bool in_string, long depth) {
+    for (size_t i = IsEscaped(text, begin) ? begin + 1 : begin; i < end; ++i) {
+        const char c = text[i];
+        if (c == '\\') {
+            ++i;
+        } else if (c == '"') {
+            in_string = !in_string;
+        } else if (in_string) {
+            continue;
+        } else if (c == '[' || c == '{') {
+            ++depth;
+        } else if (c == ']' || c == '}') {
+            --depth;
+        } else if (c == ',' && depth == 0) {
+            return i;
+        }
+    }
+    return string_view::npos;
+}
+
+}  // namespace
+
+vector<string_view> SplitArray(string_view text, size_t parts) {
+    JsonReader reader(text);
+    reader.Expect('[');
+    const size_t open = reader.Position();
+    size_t close = text.find_last_not_of(" \n\r\t");
+    if (close == string_view::npos || close < open || text[close] != ']') {
+        reader.Seek(close == string_view::npos || close < open ? text.size() : close);
+        reader.Fail("Expected ']'");
+    }
+    if (reader.Peek() == ']' && reader.Position() == close) {
+        return {};
+    }
+
+    parts = std::clamp<size_t>(parts, 1, close - open);
+    vector<size_t> starts(parts + 1);
+    for (size_t i = 0; i <= parts; ++i) {
+        starts[i] = open + (close - open) * i / parts;
+    }
+
+    // Перший прохід: підсумки діапазонів паралельно
+    vector<std::future<RangeSummary>> summaries;
+    for (size_t i = 0; i + 1 < parts; ++i) {
+        summaries.push_back(std::async(std::launch::async, SummarizeRange, text, starts[i], starts[i + 1]));
+    }
+
+    // Стан на початку кожного діапазону з префіксних сум
+    vector<bool> start_in_string(parts, false);
+    vector<long> start_depth(parts, 0);
+    for (size_t i = 0; i + 1 < parts; ++i) {
+        const RangeSummary summary = summaries[i].get();
+        start_in_string[i + 1] = start_in_string[i] != summary.odd_quotes;
+        start_depth[i + 1] = start_depth[i] +
+            (start_in_string[i] ? summary.depth_inside : summary.depth_outside);
+    }
+
+    // Другий прохід: межа кожного діапазону, крім першого, - його перша кома верхнього рівня
+    vector<std::future<size_t>> boundaries;
+    for (size_t i = 1; i < parts; ++i) {
+        boundaries.push_back(std::async(std::launch::async, FindBoundary, text, starts[i], starts[i + 1],
+                                        static_cast<bool>(start_in_string[i]), start_depth[i]));
+    }
+
+    vector<string_view> chunks;
+    size_t chunk_begin = open;
+    for (auto& future : boundaries) {
+        const size_t boundary = future.get();
+        if (boundary != string_view::npos) {
+            chunks.push_back(text.substr(chunk_begin, boundary - chunk_begin));
+            chunk_begin = boundary + 1;
+        }
+    }
+    chunks.push_back(text.substr(chunk_begin, close - chunk_begin));
+    return chunks;
+}
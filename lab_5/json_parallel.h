@@ -0,0 +1,62 @@
+#pragma once
+#include "json_reader.h"
+#include <future>
+#include <string_view>
+#include <vector>
+
+// Паралельна обробка великого масиву верхнього рівня.
+//
+// SplitArray ділить масив на шматки по комах між елементами. Щоб не сканувати
+// весь текст одним потоком, діапазони спершу проходяться паралельно: для кожного
+// рахується парність лапок і зміна глибини дужок для обох варіантів початку
+// (поза рядком і всередині рядка). Префіксна сума цих підсумків дає точний стан
+// на початку кожного діапазону, після чого межа шукається з першої коми верхнього рівня.
+
+// Повертає до parts шматків тексту між '[' і ']'; кожен шматок - кілька елементів
+// через кому. Порожній масив дає порожній вектор
+std::vector<std::string_view> SplitArray(std::string_view text, size_t parts);
+
+// Згортає масив у threads потоків: кожен шматок згортається у власний Accumulator
+// викликами on_element(acc, reader), де on_element має прочитати з reader рівно один
+// елемент. Часткові результати зливаються по порядку шматків через merge(acc, next)
+template <typename Accumulator, typename OnElement, typename Merge>
+Accumulator ParallelReduce(std::string_view text, size_t threads, OnElement on_element, Merge merge) {
+    const std::vector<std::string_view> chunks = SplitArray(text, threads);
+
+    auto reduce_chunk = [&](std::string_view chunk) {
+        Accumulator result{};
+        // Читач бачить увесь текст, тож позиції помилок рахуються від початку файлу
+        JsonReader reader(text);
+        const size_t end = chunk.data() + chunk.size() - text.data();
+        reader.Seek(chunk.data() - text.data());
+        while (true) {
+            reader.Peek();
+            if (reader.Position() >= end) {
+                reader.Fail("Expected a value");
+            }
+            on_element(result, reader);
+            reader.Peek();
+            if (reader.Position() == end) {
+                break;
+            }
+            if (reader.Position() > end) {
+                reader.Fail("Unexpected data after array element");
+            }
+            reader.Expect(',');
+        }
+        return result;
+    };
+
+    std::vector<std::future<Accumulator>> futures;
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        futures.push_back(std::async(std::launch::async, reduce_chunk, chunks[i]));
+    }
+    Accumulator result{};
+    if (!chunks.empty()) {
+        result = reduce_chunk(chunks.front());
+    }
+    for (auto& future : futures) {
+        merge(result, future.get());
+    }
+    return result;
+}
@@ -0,0 +1,115 @@
+#include "json_pointer.h"
+#include "json_reader.h"
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+using std::nullopt;
+using std::optional;
+using std::string;
+using std::string_view;
+
+namespace {
+
+// Декодує наступний токен вказівника (~1 -> '/', ~0 -> '~') і зсуває pointer за нього
+string NextToken(string_view& pointer) {
+    pointer.remove_prefix(1);
+    const size_t end = std::min(pointer.find('/'), pointer.size());
+    string token;
+    for (size_t i = 0; i < end; ++i) {
+        if (pointer[i] != '~') {
+            token.push_back(pointer[i]);
+        } else if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1')) {
+            token.push_back(pointer[++i] == '0' ? '~' : '/');
+        } else {
+            throw std::invalid_argument("Invalid escape in JSON pointer");
+        }
+    }
+    pointer.remove_prefix(end);
+    return token;
+}
+
+// Індекс масиву: десяткове число без ведучих нулів; "-" та інше - відсутній елемент
+optional<size_t> ParseIndex(string_view token) {
+    if (token.empty() || (token.size() > 1 && token[0] == '0')) {
+        return nullopt;
+    }
+    size_t index = 0;
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+    if (error != std::errc() || end != token.data() + token.size()) {
+        return nullopt;
+    }
+    return index;
+}
+
+// Ставить reader на елемент з індексом index; false, якщо масив коротший
+bool SeekElement(JsonReader& reader, string_view token) {
+    reader.Expect('[');
+    const optional<size_t> index = ParseIndex(token);
+    if (!index || reader.Peek() == ']') {
+        return false;
+    }
+    for (size_t i = 0; i < *index; ++i) {
+        reader.SkipValue();
+        if (!reader.Consume(',')) {
+            reader.Expect(']');
+            return false;
+        }
+    }
+    return true;
+}
+
+// Ставить reader на значення ключа key; при дублікатах, як і Load, береться перший
+bool SeekMember(JsonReader& reader, string_view key, string& scratch) {
+    reader.Expect('{');
+    if (reader.Consume('}')) {
+        return false;
+    }
+    do {
+        const bool found = reader.ReadString(scratch) == key;
+        reader.Expect(':');
+        if (found) {
+            return true;
+        }
+        reader.SkipValue();
+    } while (reader.Consume(','));
+    reader.Expect('}');
+    return false;
+}
+
+}  // namespace
+
+optional<string_view> FindRaw(string_view text, string_view pointer) {
+    if (!pointer.empty() && pointer.front() != '/') {
+        throw std::invalid_argument("JSON pointer must start with '/'");
+    }
+    JsonReader reader(text);
+    string scratch;
+    while (!pointer.empty()) {
+        const string token = NextToken(pointer);
+        const char next = reader.Peek();
+        if (next == '[') {
+            if (!SeekElement(reader, token)) {
+                return nullopt;
+            }
+        } else if (next == '{') {
+            if (!SeekMember(reader, token, scratch)) {
+                return nullopt;
+            }
+        } else {
+            // У скаляра немає вкладених значень
+            reader.SkipValue();
+            return nullopt;
+        }
+    }
+    return reader.ReadRawValue();
+}
+
+Node Find(string_view text, string_view pointer) {
+    const optional<string_view> raw = FindRaw(text, pointer);
+    if (!raw) {
+        throw std::out_of_range("No value at JSON pointer " + string(pointer));
+    }
+    return Load(*raw).GetRoot();
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "json.h"
+#include <optional>
+#include <string_view>
+
+// Запити JSON Pointer (RFC 6901) прямо по тексту, без побудови дерева.
+// Непотрібні значення на шляху пропускаються зіставленням дужок і лапок,
+// тож текст поза шляхом не перевіряється на коректність.
+//
+//     Find(text, "/0/amount")    - поле amount першого елемента
+//     Find(text, "/a~1b/c~0d")   - ключі "a/b" та "c~d"
+//     Find(text, "")             - увесь документ
+//
+// Вказівник без початкового '/' кидає std::invalid_argument,
+// помилки розбору на шляху - ParsingError.
+
+// Зріз тексту зі знайденим значенням або nullopt, якщо шляху немає
+std::optional<std::string_view> FindRaw(std::string_view text, std::string_view pointer);
+
+// Розбирає лише знайдене значення; кидає std::out_of_range, якщо шляху немає
+Node Find(std::string_view text, std::string_view pointer);
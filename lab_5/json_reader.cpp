@@ -0,0 +1,334 @@
+#include "json_reader.h"
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+using std::string;
+using std::string_view;
+
+ParsingError::ParsingError(const string& message, size_t offset, size_t line, size_t column)
+    : runtime_error(message + " at line " + std::to_string(line) + ", column " + std::to_string(column))
+    , offset(offset)
+    , line(line)
+    , column(column) {
+}
+
+size_t ParsingError::Offset() const {
+    return offset;
+}
+
+size_t ParsingError::Line() const {
+    return line;
+}
+
+size_t ParsingError::Column() const {
+    return column;
+}
+
+JsonReader::JsonReader(string_view text) : text(text) {
+}
+
+void JsonReader::SkipWhitespace() {
+    while (pos < text.size()) {
+        const char c = text[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            break;
+        }
+        ++pos;
+    }
+}
+
+char JsonReader::Peek() {
+    SkipWhitespace();
+    return pos < text.size() ? text[pos] : '\0';
+}
+
+bool JsonReader::AtEnd() {
+    SkipWhitespace();
+    return pos == text.size();
+}
+
+bool JsonReader::Consume(char c) {
+    if (Peek() == c && pos < text.size()) {
+        ++pos;
+        return true;
+    }
+    return false;
+}
+
+void JsonReader::Expect(char c) {
+    if (!Consume(c)) {
+        Fail(string("Expected '") + c + "'");
+    }
+}
+
+string_view JsonReader::ReadString(string& scratch) {
+    Expect('"');
+    const size_t begin = pos;
+    while (pos < text.size()) {
+        const char c = text[pos];
+        if (c == '"') {
+            return text.substr(begin, pos++ - begin);
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            Fail("Control character in string");
+        }
+        ++pos;
+    }
+
+    // Є екранування: далі збираємо рядок у scratch
+    scratch.assign(text.substr(begin, pos - begin));
+    while (pos < text.size()) {
+        const char c = text[pos++];
+        if (c == '"') {
+            return scratch;
+        }
+        if (c == '\\') {
+            ReadEscape(scratch);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            --pos;
+            Fail("Control character in string");
+        } else {
+            scratch.push_back(c);
+        }
+    }
+    Fail("Unterminated string");
+}
+
+unsigned JsonReader::ReadHex4() {
+    if (text.size() - pos < 4) {
+        Fail("Truncated \\u escape");
+    }
+    unsigned code = 0;
+    const auto [end, error] = std::from_chars(text.data() + pos, text.data() + pos + 4, code, 16);
+    if (error != std::errc() || end != text.data() + pos + 4) {
+        Fail("Invalid \\u escape");
+    }
+    pos += 4;
+    return code;
+}
+
+void JsonReader::ReadEscape(string& out) {
+    if (pos == text.size()) {
+        Fail("Unterminated string");
+    }
+    switch (const char c = text[pos++]) {
+        case '"':
+        case '\\':
+        case '/':
+            out.push_back(c);
+            return;
+        case 'b':
+            out.push_back('\b');
+            return;
+        case 'f':
+            out.push_back('\f');
+            return;
+        case 'n':
+            out.push_back('\n');
+            return;
+        case 'r':
+            out.push_back('\r');
+            return;
+        case 't':
+            out.push_back('\t');
+            return;
+        case 'u':
+            break;
+        default:
+            --pos;
+            Fail("Invalid escape sequence");
+    }
+
+    unsigned code = ReadHex4();
+    if (code >= 0xD800 && code <= 0xDBFF) {
+        // Сурогатна пара кодує символ поза базовою площиною
+        if (text.substr(pos, 2) != "\\u") {
+            Fail("Unpaired surrogate");
+        }
+        pos += 2;
+        const unsigned low = ReadHex4();
+        if (low < 0xDC00 || low > 0xDFFF) {
+            Fail("Invalid low surrogate");
+        }
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+JsonNumber JsonReader::ReadNumber() {
+    SkipWhitespace();
+    const size_t begin = pos;
+    auto digits = [this] {
+        const size_t start = pos;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            ++pos;
+        }
+        return pos - start;
+    };
+
+    if (pos < text.size() && text[pos] == '-') {
+        ++pos;
+    }
+    const size_t int_begin = pos;
+    const size_t int_digits = digits();
+    if (int_digits == 0) {
+        Fail("Expected a value");
+    }
+    if (int_digits > 1 && text[int_begin] == '0') {
+        pos = int_begin;
+        Fail("Leading zeros are not allowed");
+    }
+
+    bool is_int = true;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        is_int = false;
+        if (digits() == 0) {
+            Fail("Expected digits after decimal point");
+        }
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        is_int = false;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+            ++pos;
+        }
+        if (digits() == 0) {
+            Fail("Expected exponent digits");
+        }
+    }
+
+    const char* first = text.data() + begin;
+    const char* last = text.data() + pos;
+    JsonNumber number{false, 0, 0};
+    if (is_int) {
+        // Ціле, що не поміщається в int, стає double
+        if (std::from_chars(first, last, number.as_int).ec == std::errc()) {
+            number.is_int = true;
+            number.as_double = number.as_int;
+            return number;
+        }
+    }
+    if (std::from_chars(first, last, number.as_double).ec != std::errc()) {
+        pos = begin;
+        Fail("Number is out of range");
+    }
+    return number;
+}
+
+bool JsonReader::ReadBool() {
+    SkipWhitespace();
+    if (text.substr(pos, 4) == "true") {
+        pos += 4;
+        return true;
+    }
+    if (text.substr(pos, 5) == "false") {
+        pos += 5;
+        return false;
+    }
+    Fail("Expected a boolean");
+}
+
+void JsonReader::ReadNull() {
+    SkipWhitespace();
+    if (text.substr(pos, 4) != "null") {
+        Fail("Expected null");
+    }
+    pos += 4;
+}
+
+void JsonReader::SkipValue() {
+    const char first = Peek();
+    if (first == '"') {
+        string scratch;
+        ReadString(scratch);
+        return;
+    }
+    if (first != '[' && first != '{') {
+        // Скаляр закінчується на роздільнику
+        const size_t begin = pos;
+        while (pos < text.size()) {
+            const char c = text[pos];
+            if (c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                break;
+            }
+            ++pos;
+        }
+        if (pos == begin) {
+            Fail("Expected a value");
+        }
+        return;
+    }
+
+    size_t depth = 0;
+    while (pos < text.size()) {
+        const char c = text[pos++];
+        if (c == '"') {
+            while (pos < text.size() && text[pos] != '"') {
+                pos += text[pos] == '\\' ? 2 : 1;
+            }
+            if (pos >= text.size()) {
+                Fail("Unterminated string");
+            }
+            ++pos;
+        } else if (c == '[' || c == '{') {
+            ++depth;
+        } else if (c == ']' || c == '}') {
+            if (--depth == 0) {
+                return;
+            }
+        }
+    }
+    Fail("Unterminated container");
+}
+
+string_view JsonReader::ReadRawValue() {
+    SkipWhitespace();
+    const size_t begin = pos;
+    SkipValue();
+    return text.substr(begin, pos - begin);
+}
+
+size_t JsonReader::Position() const {
+    return pos;
+}
+
+void JsonReader::Seek(size_t position) {
+    pos = std::min(position, text.size());
+}
+
+string_view JsonReader::Text() const {
+    return text;
+}
+
+void JsonReader::Fail(const string& message) const {
+    size_t line = 1;
+    size_t line_start = 0;
+    const size_t end = std::min(pos, text.size());
+    for (size_t i = 0; i < end; ++i) {
+        if (text[i] == '\n') {
+            ++line;
+            line_start = i + 1;
+        }
+    }
+    throw ParsingError(message, end, line, end - line_start + 1);
+}
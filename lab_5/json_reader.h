@@ -0,0 +1,63 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Помилка розбору з позицією у вхідному тексті (рядки й стовпці з 1)
+class ParsingError : public std::runtime_error {
+public:
+    ParsingError(const std::string& message, size_t offset, size_t line, size_t column);
+    size_t Offset() const;
+    size_t Line() const;
+    size_t Column() const;
+private:
+    size_t offset;
+    size_t line;
+    size_t column;
+};
+
+// Число JSON: ціле, якщо поміщається в int і не має дробової частини чи експоненти
+struct JsonNumber {
+    bool is_int;
+    int as_int;
+    double as_double;
+};
+
+// Низькорівневе читання JSON із суцільного буфера без копіювання.
+// Буфер має жити, доки використовуються повернуті string_view
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text);
+
+    // Наступний значущий символ без його споживання; '\0' в кінці тексту
+    char Peek();
+    bool AtEnd();
+    // Споживає c, якщо він наступний значущий символ
+    bool Consume(char c);
+    void Expect(char c);
+
+    // Рядок без екранування повертається як зріз джерела, інакше декодується в scratch
+    std::string_view ReadString(std::string& scratch);
+    JsonNumber ReadNumber();
+    bool ReadBool();
+    void ReadNull();
+
+    // Пропускає значення будь-якого типу, лише зіставляючи дужки та лапки
+    void SkipValue();
+    // Пропускає значення і повертає його текст
+    std::string_view ReadRawValue();
+
+    size_t Position() const;
+    // Переставляє читання на довільну позицію тексту
+    void Seek(size_t position);
+    std::string_view Text() const;
+    [[noreturn]] void Fail(const std::string& message) const;
+
+private:
+    void SkipWhitespace();
+    void ReadEscape(std::string& out);
+    unsigned ReadHex4();
+
+    std::string_view text;
+    size_t pos = 0;
+};
@@ -0,0 +1,187 @@
+#include "json_stream.h"
+#include "json_reader.h"
+#include <algorithm>
+
+using std::string;
+using std::string_view;
+
+void ElementScanner::Reset() {
+    depth = 0;
+    in_string = false;
+    escaped = false;
+    started = false;
+}
+
+size_t ElementScanner::Scan(string_view data, size_t from) {
+    for (size_t i = from; i < data.size(); ++i) {
+        const char c = data[i];
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+                if (depth == 0) {
+                    return i + 1;
+                }
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                in_string = true;
+                started = true;
+                break;
+            case '[':
+            case '{':
+                ++depth;
+                started = true;
+                break;
+            case ']':
+            case '}':
+                if (depth == 0) {
+                    return i;
+                }
+                if (--depth == 0) {
+                    return i + 1;
+                }
+                break;
+            case ',':
+            case ' ':
+            case '\n':
+            case '\r':
+            case '\t':
+                if (depth == 0 && started) {
+                    return i;
+                }
+                break;
+            default:
+                started = true;
+                break;
+        }
+    }
+    return NPOS;
+}
+
+bool ElementScanner::InTopLevelScalar() const {
+    return started && depth == 0 && !in_string;
+}
+
+ArrayStreamReader::ArrayStreamReader(std::istream& input, size_t chunk_size)
+    : input(input)
+    , chunk_size(std::max<size_t>(chunk_size, 1)) {
+}
+
+bool ArrayStreamReader::Fill() {
+    const size_t old_size = buffer.size();
+    buffer.resize(old_size + chunk_size);
+    input.read(buffer.data() + old_size, chunk_size);
+    buffer.resize(old_size + input.gcount());
+    return buffer.size() > old_size;
+}
+
+// Відкидає вже прочитані байти, запам'ятовуючи рядки для повідомлень про помилки
+void ArrayStreamReader::Compact() {
+    for (size_t i = 0; i < pos; ++i) {
+        if (buffer[i] == '\n') {
+            ++discarded_lines;
+            line_start = discarded_bytes + i + 1;
+        }
+    }
+    buffer.erase(0, pos);
+    discarded_bytes += pos;
+    pos = 0;
+}
+
+void ArrayStreamReader::Fail(const string& message) const {
+    size_t line = discarded_lines + 1;
+    size_t start = line_start;
+    for (size_t i = 0; i < pos && i < buffer.size(); ++i) {
+        if (buffer[i] == '\n') {
+            ++line;
+            start = discarded_bytes + i + 1;
+        }
+    }
+    const size_t offset = discarded_bytes + pos;
+    throw ParsingError(message, offset, line, offset - start + 1);
+}
+
+// Після масиву допускаються лише пробіли, як і в Load
+void ArrayStreamReader::CheckTrailingData() {
+    while (true) {
+        if (pos == buffer.size()) {
+            Compact();
+            if (!Fill()) {
+                return;
+            }
+        }
+        const char c = buffer[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            Fail("Unexpected data after JSON value");
+        }
+        ++pos;
+    }
+}
+
+bool ArrayStreamReader::Next(string_view& element) {
+    if (finished) {
+        return false;
+    }
+    // Зсуваємо буфер лише коли прочитаного набралось на цілий блок,
+    // щоб не переносити хвіст буфера на кожному елементі
+    if (pos >= chunk_size) {
+        Compact();
+    }
+
+    while (true) {
+        if (pos == buffer.size() && !Fill()) {
+            Fail("Unexpected end of input");
+        }
+        const char c = buffer[pos];
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            ++pos;
+        } else if (!started) {
+            if (c != '[') {
+                Fail("Expected '['");
+            }
+            started = true;
+            ++pos;
+        } else if (c == ']' && !after_comma) {
+            finished = true;
+            ++pos;
+            CheckTrailingData();
+            return false;
+        } else if (c == ',' && need_comma) {
+            need_comma = false;
+            after_comma = true;
+            ++pos;
+        } else if (need_comma) {
+            Fail("Expected ',' or ']'");
+        } else if (c == ',' || c == ']') {
+            Fail("Expected a value");
+        } else {
+            break;
+        }
+    }
+
+    scanner.Reset();
+    size_t scan_from = pos;
+    size_t end;
+    while ((end = scanner.Scan(buffer, scan_from)) == ElementScanner::NPOS) {
+        scan_from = buffer.size();
+        if (!Fill()) {
+            if (!scanner.InTopLevelScalar()) {
+                pos = buffer.size();
+                Fail("Unexpected end of input");
+            }
+            end = buffer.size();
+            break;
+        }
+    }
+    element = string_view(buffer).substr(pos, end - pos);
+    pos = end;
+    need_comma = true;
+    after_comma = false;
+    return true;
+}
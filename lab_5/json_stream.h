@@ -0,0 +1,55 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <string_view>
+
+// Знаходить кінець одного значення JSON, зіставляючи лише дужки й лапки.
+// Стан зберігається між викликами, тож дані можна подавати частинами
+class ElementScanner {
+public:
+    static constexpr size_t NPOS = std::string_view::npos;
+
+    void Reset();
+    // Сканує data з позиції from; повертає позицію одразу за кінцем значення
+    // або NPOS, якщо значення ще не закінчилось
+    size_t Scan(std::string_view data, size_t from);
+    // Скаляр верхнього рівня, що може закінчитись разом із вхідними даними
+    bool InTopLevelScalar() const;
+
+private:
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    bool started = false;
+};
+
+// Потокове читання елементів масиву верхнього рівня: у пам'яті тримається
+// лише поточний елемент і один блок вхідних даних
+class ArrayStreamReader {
+public:
+    explicit ArrayStreamReader(std::istream& input, size_t chunk_size = 64 * 1024);
+
+    // Текст наступного елемента; дійсний до наступного виклику.
+    // Повертає false, коли масив закінчився; дані після нього, крім пробілів,
+    // кидають ParsingError
+    bool Next(std::string_view& element);
+
+private:
+    bool Fill();
+    void Compact();
+    void CheckTrailingData();
+    [[noreturn]] void Fail(const std::string& message) const;
+
+    std::istream& input;
+    size_t chunk_size;
+    std::string buffer;
+    size_t pos = 0;
+    size_t discarded_bytes = 0;
+    size_t discarded_lines = 0;
+    size_t line_start = 0;        // абсолютне зміщення початку поточного рядка
+    bool started = false;
+    bool finished = false;
+    bool need_comma = false;
+    bool after_comma = false;
+    ElementScanner scanner;
+};
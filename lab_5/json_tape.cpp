@@ -0,0 +1,513 @@
+#include "json_tape.h"
+#include "json_reader.h"
+#include <cstring>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define JSON_TAPE_X86 1
+#include <immintrin.h>
+#endif
+
+using std::map;
+using std::move;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace {
+
+constexpr size_t BLOCK = 64;
+
+// Бітові маски класів символів у блоці з 64 байт
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;
+    uint64_t space;
+};
+
+BlockMasks ClassifyScalar(const char* block) {
+    BlockMasks masks{0, 0, 0, 0};
+    for (size_t i = 0; i < BLOCK; ++i) {
+        const uint64_t bit = uint64_t(1) << i;
+        switch (block[i]) {
+            case '"':
+                masks.quote |= bit;
+                break;
+            case '\\':
+                masks.backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                masks.op |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                masks.space |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+    return masks;
+}
+
+#ifdef JSON_TAPE_X86
+
+// Вбудовані функції не успадковують target-атрибут лямбд, тому порівняння записані явно
+__attribute__((target("sse2")))
+BlockMasks ClassifySse2(const char* block) {
+    BlockMasks masks{0, 0, 0, 0};
+    for (size_t i = 0; i < BLOCK; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        const __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+        const __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+        const __m128i op = _mm_or_si128(
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('[')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']')))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        const __m128i space = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        masks.quote |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(quote))) << i;
+        masks.backslash |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(backslash))) << i;
+        masks.op |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(op))) << i;
+        masks.space |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(space))) << i;
+    }
+    return masks;
+}
+
+__attribute__((target("avx2")))
+BlockMasks ClassifyAvx2(const char* block) {
+    BlockMasks masks{0, 0, 0, 0};
+    for (size_t i = 0; i < BLOCK; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        const __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+        const __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+        const __m256i op = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']')))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+        const __m256i space = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        masks.quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(quote))) << i;
+        masks.backslash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(backslash))) << i;
+        masks.op |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << i;
+        masks.space |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(space))) << i;
+    }
+    return masks;
+}
+
+#endif
+
+// Біт i результату - XOR бітів 0..i: одиниці між відкривальною й закривальною лапкою
+uint64_t PrefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+[[noreturn]] void FailAt(string_view text, size_t position, const string& message) {
+    JsonReader reader(text);
+    reader.Seek(position);
+    reader.Fail(message);
+}
+
+}  // namespace
+
+Stage1Kernel DetectStage1Kernel() {
+#ifdef JSON_TAPE_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return Stage1Kernel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Stage1Kernel::Sse2;
+    }
+#endif
+    return Stage1Kernel::Scalar;
+}
+
+vector<uint32_t> FindStructuralIndexes(string_view text, Stage1Kernel kernel) {
+    if (text.size() > UINT32_MAX) {
+        throw std::length_error("JSON text is too large for 32-bit structural indexes");
+    }
+
+    BlockMasks (*classify)(const char*) = ClassifyScalar;
+#ifdef JSON_TAPE_X86
+    if (kernel == Stage1Kernel::Avx2) {
+        classify = ClassifyAvx2;
+    } else if (kernel == Stage1Kernel::Sse2) {
+        classify = ClassifySse2;
+    }
+#endif
+
+    vector<uint32_t> indexes;
+    indexes.reserve(text.size() / 8);
+
+    uint64_t prev_in_string = 0;   // усі одиниці, якщо попередній блок закінчився всередині рядка
+    uint64_t prev_scalar = 0;      // останній байт попереднього блоку був частиною скаляра
+    bool escape_next = false;      // перший байт блоку екранований
+
+    for (size_t base = 0; base < text.size(); base += BLOCK) {
+        const char* block = text.data() + base;
+        char padded[BLOCK];
+        if (text.size() - base < BLOCK) {
+            // Хвіст доповнюємо пробілами, які не дають жодних структурних бітів
+            std::memset(padded, ' ', BLOCK);
+            std::memcpy(padded, block, text.size() - base);
+            block = padded;
+        }
+        const BlockMasks masks = classify(block);
+
+        // Зворотні косі рідкісні, тому екранування розбираємо звичайним циклом
+        uint64_t escaped = escape_next ? 1 : 0;
+        escape_next = false;
+        for (uint64_t bits = masks.backslash; bits != 0; bits &= bits - 1) {
+            const int bit = __builtin_ctzll(bits);
+            if ((escaped >> bit) & 1) {
+                continue;
+            }
+            if (bit == 63) {
+                escape_next = true;
+            } else {
+                escaped |= uint64_t(1) << (bit + 1);
+            }
+        }
+
+        const uint64_t quote = masks.quote & ~escaped;
+        const uint64_t in_string = PrefixXor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        const uint64_t scalar = ~(masks.op | masks.space | quote) & ~in_string;
+        const uint64_t scalar_starts = scalar & ~((scalar << 1) | prev_scalar);
+        prev_scalar = scalar >> 63;
+
+        uint64_t structurals = (masks.op & ~in_string) | (quote & in_string) | scalar_starts;
+        while (structurals != 0) {
+            indexes.push_back(static_cast<uint32_t>(base + __builtin_ctzll(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+
+    if (prev_in_string != 0) {
+        FailAt(text, text.size(), "Unterminated string");
+    }
+    return indexes;
+}
+
+vector<uint32_t> FindStructuralIndexes(string_view text) {
+    static const Stage1Kernel kernel = DetectStage1Kernel();
+    return FindStructuralIndexes(text, kernel);
+}
+
+namespace {
+
+uint64_t MakeEntry(char tag, uint64_t payload = 0) {
+    return (static_cast<uint64_t>(static_cast<unsigned char>(tag)) << 56) | payload;
+}
+
+constexpr uint64_t PAYLOAD_MASK = (uint64_t(1) << 56) - 1;
+
+}  // namespace
+
+TapeDocument::TapeDocument(string_view text) : text(text) {
+    Build(FindStructuralIndexes(text));
+}
+
+TapeDocument::TapeDocument(string_view text, Stage1Kernel kernel) : text(text) {
+    Build(FindStructuralIndexes(text, kernel));
+}
+
+void TapeDocument::Build(const vector<uint32_t>& indexes) {
+    enum class State {
+        Value,
+        Key,
+        AfterValue,
+    };
+
+    JsonReader reader(text);
+    tape.reserve(indexes.size() + 1);
+    vector<size_t> open;   // індекси відкритих контейнерів на стрічці
+    size_t i = 0;
+    State state = State::Value;
+
+    auto next = [&]() -> size_t {
+        if (i == indexes.size()) {
+            FailAt(text, text.size(), "Unexpected end of input");
+        }
+        return indexes[i++];
+    };
+    // Після скаляра чи рядка до наступного структурного символу можуть бути лише пробіли
+    auto check_token_end = [&] {
+        reader.Peek();
+        const size_t expected = i < indexes.size() ? indexes[i] : text.size();
+        if (reader.Position() != expected) {
+            reader.Fail("Invalid value");
+        }
+    };
+    auto add_string = [&](size_t position) {
+        string scratch;
+        reader.Seek(position);
+        string_view value = reader.ReadString(scratch);
+        if (value.data() == scratch.data()) {
+            value = decoded.emplace_back(move(scratch));
+        }
+        tape.push_back(MakeEntry('"', strings.size()));
+        strings.push_back(value);
+        check_token_end();
+    };
+    auto close = [&](char tag) {
+        const size_t start = open.back();
+        open.pop_back();
+        tape[start] |= tape.size() + 1;
+        tape.push_back(MakeEntry(tag, start));
+    };
+
+    while (true) {
+        if (state == State::Value) {
+            const size_t position = next();
+            const char c = text[position];
+            state = State::AfterValue;
+            if (c == '{' || c == '[') {
+                open.push_back(tape.size());
+                tape.push_back(MakeEntry(c));
+                const char closing = c == '{' ? '}' : ']';
+                if (i < indexes.size() && text[indexes[i]] == closing) {
+                    ++i;
+                    close(closing);
+                } else {
+                    state = c == '{' ? State::Key : State::Value;
+                }
+            } else if (c == '"') {
+                add_string(position);
+            } else if (c == 't' || c == 'f') {
+                reader.Seek(position);
+                tape.push_back(MakeEntry(reader.ReadBool() ? 't' : 'f'));
+                check_token_end();
+            } else if (c == 'n') {
+                reader.Seek(position);
+                reader.ReadNull();
+                tape.push_back(MakeEntry('n'));
+                check_token_end();
+            } else if (c == '-' || (c >= '0' && c <= '9')) {
+                reader.Seek(position);
+                const JsonNumber number = reader.ReadNumber();
+                uint64_t raw;
+                if (number.is_int) {
+                    tape.push_back(MakeEntry('i'));
+                    raw = static_cast<uint64_t>(static_cast<int64_t>(number.as_int));
+                } else {
+                    tape.push_back(MakeEntry('d'));
+                    std::memcpy(&raw, &number.as_double, sizeof(raw));
+                }
+                tape.push_back(raw);
+                check_token_end();
+            } else {
+                FailAt(text, position, "Expected a value");
+            }
+        } else if (state == State::Key) {
+            const size_t position = next();
+            if (text[position] != '"') {
+                FailAt(text, position, "Expected '\"'");
+            }
+            add_string(position);
+            const size_t colon = next();
+            if (text[colon] != ':') {
+                FailAt(text, colon, "Expected ':'");
+            }
+            state = State::Value;
+        } else {
+            if (open.empty()) {
+                if (i != indexes.size()) {
+                    FailAt(text, indexes[i], "Unexpected data after JSON value");
+                }
+                return;
+            }
+            const size_t position = next();
+            const char c = text[position];
+            const char top = static_cast<char>(tape[open.back()] >> 56);
+            if (c == ',') {
+                state = top == '{' ? State::Key : State::Value;
+            } else if ((c == '}' && top == '{') || (c == ']' && top == '[')) {
+                close(c);
+            } else {
+                FailAt(text, position, top == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+        }
+    }
+}
+
+TapeValue TapeDocument::GetRoot() const {
+    return TapeValue(*this, 0);
+}
+
+TapeValue::TapeValue(const TapeDocument& doc, size_t index) : doc(&doc), index(index) {
+}
+
+char TapeValue::Tag() const {
+    return static_cast<char>(doc->tape[index] >> 56);
+}
+
+size_t TapeValue::Next(size_t i) const {
+    const uint64_t entry = doc->tape[i];
+    switch (static_cast<char>(entry >> 56)) {
+        case '[':
+        case '{':
+            return entry & PAYLOAD_MASK;
+        case 'i':
+        case 'd':
+            return i + 2;
+        default:
+            return i + 1;
+    }
+}
+
+Node::Type TapeValue::GetType() const {
+    switch (Tag()) {
+        case '[':
+            return Node::Type::Array;
+        case '{':
+            return Node::Type::Map;
+        case 'i':
+            return Node::Type::Int;
+        case '"':
+            return Node::Type::String;
+        case 'd':
+            return Node::Type::Double;
+        case 't':
+        case 'f':
+            return Node::Type::Bool;
+        default:
+            return Node::Type::Null;
+    }
+}
+
+int TapeValue::AsInt() const {
+    if (Tag() != 'i') {
+        throw std::logic_error("Tape value is not an int");
+    }
+    return static_cast<int>(static_cast<int64_t>(doc->tape[index + 1]));
+}
+
+double TapeValue::AsDouble() const {
+    if (Tag() == 'i') {
+        return AsInt();
+    }
+    if (Tag() != 'd') {
+        throw std::logic_error("Tape value is not a number");
+    }
+    double value;
+    std::memcpy(&value, &doc->tape[index + 1], sizeof(value));
+    return value;
+}
+
+bool TapeValue::AsBool() const {
+    if (Tag() != 't' && Tag() != 'f') {
+        throw std::logic_error("Tape value is not a bool");
+    }
+    return Tag() == 't';
+}
+
+bool TapeValue::IsNull() const {
+    return Tag() == 'n';
+}
+
+string_view TapeValue::AsString() const {
+    if (Tag() != '"') {
+        throw std::logic_error("Tape value is not a string");
+    }
+    return doc->strings[doc->tape[index] & PAYLOAD_MASK];
+}
+
+size_t TapeValue::Size() const {
+    size_t size = 0;
+    if (Tag() == '[') {
+        ForEachElement([&size](TapeValue) {
+            ++size;
+        });
+    } else if (Tag() == '{') {
+        ForEachMember([&size](string_view, TapeValue) {
+            ++size;
+        });
+    } else {
+        throw std::logic_error("Tape value is not a container");
+    }
+    return size;
+}
+
+TapeValue TapeValue::operator[](size_t position) const {
+    if (Tag() != '[') {
+        throw std::logic_error("Tape value is not an array");
+    }
+    size_t i = index + 1;
+    for (; position > 0 && doc->tape[i] >> 56 != ']'; --position) {
+        i = Next(i);
+    }
+    if (doc->tape[i] >> 56 == ']') {
+        throw std::out_of_range("Array index is out of range");
+    }
+    return TapeValue(*doc, i);
+}
+
+TapeValue TapeValue::At(string_view key) const {
+    if (Tag() != '{') {
+        throw std::logic_error("Tape value is not an object");
+    }
+    for (size_t i = index + 1; doc->tape[i] >> 56 != '}'; ) {
+        const bool found = TapeValue(*doc, i).AsString() == key;
+        i = Next(i);
+        if (found) {
+            return TapeValue(*doc, i);
+        }
+        i = Next(i);
+    }
+    throw std::out_of_range("Key not found: " + string(key));
+}
+
+Node TapeValue::ToNode() const {
+    switch (Tag()) {
+        case '[': {
+            vector<Node> items;
+            ForEachElement([&items](TapeValue item) {
+                items.push_back(item.ToNode());
+            });
+            return Node(move(items));
+        }
+        case '{': {
+            map<string, Node> members;
+            ForEachMember([&members](string_view key, TapeValue value) {
+                members.emplace(string(key), value.ToNode());
+            });
+            return Node(move(members));
+        }
+        case 'i':
+            return Node(AsInt());
+        case 'd':
+            return Node(AsDouble());
+        case '"':
+            return Node(string(AsString()));
+        case 't':
+        case 'f':
+            return Node(AsBool());
+        default:
+            return Node(nullptr);
+    }
+}
+
+Document LoadTape(string_view text) {
+    TapeDocument tape(text);
+    return Document(tape.GetRoot().ToNode());
+}
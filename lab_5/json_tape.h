@@ -0,0 +1,103 @@
+#pragma once
+#include "json.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Двоетапний розбір у стилі simdjson.
+// Етап 1 блоками по 64 байти будує бітові маски лапок, структурних символів
+// і пробілів та видає позиції всіх структурних символів поза рядками
+// (а також початки рядків і скалярів).
+// Етап 2 проходить лише по цих позиціях і записує "стрічку" (tape):
+// плаский масив 64-бітних записів, де контейнер знає індекс свого кінця.
+
+enum class Stage1Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Найшвидше ядро, яке підтримує поточний процесор
+Stage1Kernel DetectStage1Kernel();
+std::vector<uint32_t> FindStructuralIndexes(std::string_view text, Stage1Kernel kernel);
+std::vector<uint32_t> FindStructuralIndexes(std::string_view text);
+
+class TapeDocument;
+
+// Перегляд значення на стрічці; живе, доки живе TapeDocument
+class TapeValue {
+public:
+    TapeValue(const TapeDocument& doc, size_t index);
+
+    Node::Type GetType() const;
+    int AsInt() const;
+    double AsDouble() const;
+    bool AsBool() const;
+    bool IsNull() const;
+    std::string_view AsString() const;
+
+    // Кількість елементів масиву або пар об'єкта
+    size_t Size() const;
+    TapeValue operator[](size_t index) const;
+    // Лінійний пошук ключа в об'єкті; кидає std::out_of_range
+    TapeValue At(std::string_view key) const;
+
+    // Обхід елементів масиву: callback(TapeValue)
+    template <typename Callback>
+    void ForEachElement(Callback callback) const;
+    // Обхід пар об'єкта: callback(string_view key, TapeValue value)
+    template <typename Callback>
+    void ForEachMember(Callback callback) const;
+
+    Node ToNode() const;
+
+private:
+    char Tag() const;
+    size_t Next(size_t index) const;
+
+    const TapeDocument* doc;
+    size_t index;
+};
+
+class TapeDocument {
+public:
+    explicit TapeDocument(std::string_view text);
+    TapeDocument(std::string_view text, Stage1Kernel kernel);
+    TapeDocument(const TapeDocument&) = delete;
+    TapeDocument& operator=(const TapeDocument&) = delete;
+
+    TapeValue GetRoot() const;
+
+private:
+    friend class TapeValue;
+
+    void Build(const std::vector<uint32_t>& indexes);
+
+    std::string_view text;
+    std::vector<uint64_t> tape;
+    std::vector<std::string_view> strings;
+    // Рядки з екрануванням; deque не переміщує елементи при додаванні
+    std::deque<std::string> decoded;
+};
+
+// Розбір через стрічку з перетворенням у звичайний Document
+Document LoadTape(std::string_view text);
+
+template <typename Callback>
+void TapeValue::ForEachElement(Callback callback) const {
+    for (size_t i = index + 1; doc->tape[i] >> 56 != ']'; i = Next(i)) {
+        callback(TapeValue(*doc, i));
+    }
+}
+
+template <typename Callback>
+void TapeValue::ForEachMember(Callback callback) const {
+    for (size_t i = index + 1; doc->tape[i] >> 56 != '}'; ) {
+        const std::string_view key = TapeValue(*doc, i).AsString();
+        i = Next(i);
+        callback(key, TapeValue(*doc, i));
+        i = Next(i);
+    }
+}
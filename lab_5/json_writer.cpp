@@ -0,0 +1,242 @@
+#include "json_writer.h"
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+using std::string;
+using std::string_view;
+
+StringWriter::StringWriter(string& output) : output(output) {
+}
+
+void StringWriter::Write(string_view data) {
+    output.append(data);
+}
+
+StreamWriter::StreamWriter(std::ostream& output) : output(output) {
+}
+
+void StreamWriter::Write(string_view data) {
+    output.write(data.data(), data.size());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+FdWriter::FdWriter(int fd) : fd(fd) {
+}
+
+void FdWriter::Write(string_view data) {
+    while (!data.empty()) {
+        const ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Could not write JSON");
+        }
+        data.remove_prefix(written);
+    }
+}
+#endif
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+class Serializer {
+public:
+    Serializer(Writer& writer, SaveFormat format) : writer(writer), pretty(format == SaveFormat::Pretty) {
+        buffer.reserve(BUFFER_SIZE + 64);
+    }
+
+    void WriteNode(const Node& node) {
+        switch (node.GetType()) {
+            case Node::Type::Array:
+                WriteArray(node);
+                break;
+            case Node::Type::Map:
+                WriteMap(node);
+                break;
+            case Node::Type::Int:
+                WriteInt(node.AsInt());
+                break;
+            case Node::Type::String:
+                WriteString(node.AsString());
+                break;
+            case Node::Type::Double:
+                WriteDouble(node.AsDouble());
+                break;
+            case Node::Type::Bool:
+                Append(node.AsBool() ? "true" : "false");
+                break;
+            case Node::Type::Null:
+                Append("null");
+                break;
+        }
+    }
+
+    void Flush() {
+        if (!buffer.empty()) {
+            writer.Write(buffer);
+            buffer.clear();
+        }
+    }
+
+private:
+    void Append(string_view data) {
+        buffer.append(data);
+        if (buffer.size() >= BUFFER_SIZE) {
+            Flush();
+        }
+    }
+
+    void Append(char c) {
+        buffer.push_back(c);
+        if (buffer.size() >= BUFFER_SIZE) {
+            Flush();
+        }
+    }
+
+    void NewLine() {
+        if (pretty) {
+            Append('\n');
+            buffer.append(depth * 2, ' ');
+        }
+    }
+
+    void WriteArray(const Node& node) {
+        const auto& items = node.AsArray();
+        Append('[');
+        ++depth;
+        bool first = true;
+        for (const Node& item : items) {
+            if (!first) {
+                Append(',');
+            }
+            first = false;
+            NewLine();
+            WriteNode(item);
+        }
+        --depth;
+        if (!items.empty()) {
+            NewLine();
+        }
+        Append(']');
+    }
+
+    void WriteMap(const Node& node) {
+        const auto& members = node.AsMap();
+        Append('{');
+        ++depth;
+        bool first = true;
+        for (const auto& [key, value] : members) {
+            if (!first) {
+                Append(',');
+            }
+            first = false;
+            NewLine();
+            WriteString(key);
+            Append(pretty ? ": " : ":");
+            WriteNode(value);
+        }
+        --depth;
+        if (!members.empty()) {
+            NewLine();
+        }
+        Append('}');
+    }
+
+    void WriteInt(int value) {
+        char digits[16];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        Append(string_view(digits, result.ptr - digits));
+    }
+
+    void WriteDouble(double value) {
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument("JSON cannot represent NaN or infinity");
+        }
+        char digits[32];
+        char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        // Без крапки чи експоненти число прочиталося б назад як ціле
+        if (string_view(digits, end - digits).find_first_of(".e") == string_view::npos) {
+            *end++ = '.';
+            *end++ = '0';
+        }
+        Append(string_view(digits, end - digits));
+    }
+
+    void WriteString(string_view value) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        Append('"');
+        // Символи без екранування копіюються суцільними відрізками
+        size_t run = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+            const unsigned char c = value[i];
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            Append(value.substr(run, i - run));
+            run = i + 1;
+            switch (c) {
+                case '"':
+                    Append("\\\"");
+                    break;
+                case '\\':
+                    Append("\\\\");
+                    break;
+                case '\n':
+                    Append("\\n");
+                    break;
+                case '\r':
+                    Append("\\r");
+                    break;
+                case '\t':
+                    Append("\\t");
+                    break;
+                case '\b':
+                    Append("\\b");
+                    break;
+                case '\f':
+                    Append("\\f");
+                    break;
+                default: {
+                    const char escape[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                    Append(string_view(escape, sizeof(escape)));
+                }
+            }
+        }
+        Append(value.substr(run));
+        Append('"');
+    }
+
+    Writer& writer;
+    const bool pretty;
+    size_t depth = 0;
+    string buffer;
+};
+
+}  // namespace
+
+void Save(const Node& node, Writer& writer, SaveFormat format) {
+    Serializer serializer(writer, format);
+    serializer.WriteNode(node);
+    serializer.Flush();
+}
+
+void Save(const Document& document, Writer& writer, SaveFormat format) {
+    Save(document.GetRoot(), writer, format);
+}
+
+string SaveToString(const Document& document, SaveFormat format) {
+    string result;
+    StringWriter writer(result);
+    Save(document, writer, format);
+    return result;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "json.h"
+#include <string>
+#include <string_view>
+
+// Приймач виводу серіалізатора
+class Writer {
+public:
+    virtual ~Writer() = default;
+    virtual void Write(std::string_view data) = 0;
+};
+
+// Дописує вивід у рядок
+class StringWriter : public Writer {
+public:
+    explicit StringWriter(std::string& output);
+    void Write(std::string_view data) override;
+private:
+    std::string& output;
+};
+
+// Дописує вивід у потік
+class StreamWriter : public Writer {
+public:
+    explicit StreamWriter(std::ostream& output);
+    void Write(std::string_view data) override;
+private:
+    std::ostream& output;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+// Пише прямо у файловий дескриптор через write(2); дескриптор не закривається
+class FdWriter : public Writer {
+public:
+    explicit FdWriter(int fd);
+    void Write(std::string_view data) override;
+private:
+    int fd;
+};
+#endif
+
+enum class SaveFormat {
+    Compact,
+    // Відступ у два пробіли, кожен елемент з нового рядка
+    Pretty,
+};
+
+// Вивід накопичується в буфері й віддається у Writer блоками по BUFFER_SIZE.
+// Числа форматуються через to_chars: double - найкоротшим представленням,
+// яке читається назад без втрат, і завжди з дробовою частиною або експонентою.
+// NaN і нескінченності в JSON не представимі - кидається std::invalid_argument
+void Save(const Node& node, Writer& writer, SaveFormat format = SaveFormat::Compact);
+void Save(const Document& document, Writer& writer, SaveFormat format = SaveFormat::Compact);
+std::string SaveToString(const Document& document, SaveFormat format = SaveFormat::Compact);
@@ -1,38 +1,75 @@
 #include "json.h"
+#include "json_reader.h"
 #include <iostream>
+#include <iterator>
 
 using std::vector;
 using std::map;
 using std::string;
 using std::istream;
+using std::string_view;
 using std::move;
 
-Node::Node(vector<Node> array) : as_array(move(array)) {
+Node::Node(vector<Node> array) : value(move(array)) {
 }
 
-Node::Node(map<string, Node> map) : as_map(move(map)){
+Node::Node(map<string, Node> map) : value(move(map)) {
 }
 
-Node::Node(int value) : as_int(value) {
+Node::Node(int value) : value(value) {
 }
 
-Node::Node(string value) : as_string(move(value)) {
+Node::Node(string value) : value(move(value)) {
+}
+
+Node::Node(const char* value) : value(string(value)) {
+}
+
+Node::Node(double value) : value(value) {
+}
+
+Node::Node(bool value) : value(value) {
+}
+
+Node::Node(std::nullptr_t) : value(nullptr) {
+}
+
+Node::Node() : value(nullptr) {
+}
+
+Node::Type Node::GetType() const {
+    return static_cast<Type>(value.index());
 }
 
 const vector<Node>& Node::AsArray() const {
-    return as_array;
+    return std::get<vector<Node>>(value);
 }
 
 const map<string, Node>& Node::AsMap() const {
-    return as_map;
+    return std::get<map<string, Node>>(value);
 }
 
 int Node::AsInt() const {
-    return as_int;
+    return std::get<int>(value);
 }
 
 const string& Node::AsString() const {
-    return as_string;
+    return std::get<string>(value);
+}
+
+double Node::AsDouble() const {
+    if (const int* as_int = std::get_if<int>(&value)) {
+        return *as_int;
+    }
+    return std::get<double>(value);
+}
+
+bool Node::AsBool() const {
+    return std::get<bool>(value);
+}
+
+bool Node::IsNull() const {
+    return std::holds_alternative<std::nullptr_t>(value);
 }
 
 Document::Document(Node root) : root(move(root)) {
@@ -42,62 +79,77 @@ const Node& Document::GetRoot() const {
     return root;
 }
 
-Node LoadNode(istream& input);
+Node LoadNode(JsonReader& reader);
 
-Node LoadArray(istream& input) {
+Node LoadArray(JsonReader& reader) {
     vector<Node> result;
-    for (char c; input >> c && c != ']'; ) {
-        if (c != ',') {
-            input.putback(c);
-        }
-        result.push_back(LoadNode(input));
+    reader.Expect('[');
+    if (reader.Consume(']')) {
+        return Node(move(result));
     }
+    do {
+        result.push_back(LoadNode(reader));
+    } while (reader.Consume(','));
+    reader.Expect(']');
     return Node(move(result));
 }
 
-Node LoadInt(istream& input) {
-    int result = 0;
-    while (isdigit(input.peek())) {
-        result *= 10;
-        result += input.get() - '0';
-    }
-    return Node(result);
+Node LoadNumber(JsonReader& reader) {
+    const JsonNumber number = reader.ReadNumber();
+    return number.is_int ? Node(number.as_int) : Node(number.as_double);
 }
 
-Node LoadString(istream& input) {
-    string line;
-    getline(input, line, '"');
-    return Node(move(line));
+Node LoadString(JsonReader& reader) {
+    string scratch;
+    return Node(string(reader.ReadString(scratch)));
 }
 
-Node LoadDict(istream& input) {
+Node LoadDict(JsonReader& reader) {
     map<string, Node> result;
-    for (char c; input >> c && c != '}'; ) {
-        if (c == ',') {
-            input >> c;
-        }
-        string key = LoadString(input).AsString();
-        input >> c;
-        result.insert({move(key), LoadNode(input)});
+    reader.Expect('{');
+    if (reader.Consume('}')) {
+        return Node(move(result));
     }
+    string scratch;
+    do {
+        string key(reader.ReadString(scratch));
+        reader.Expect(':');
+        result.insert({move(key), LoadNode(reader)});
+    } while (reader.Consume(','));
+    reader.Expect('}');
     return Node(move(result));
 }
 
-Node LoadNode(istream& input) {
-    char c;
-    input >> c;
-    if (c == '[') {
-        return LoadArray(input);
-    } else if (c == '{') {
-        return LoadDict(input);
-    } else if (c == '"') {
-        return LoadString(input);
-    } else {
-        input.putback(c);
-        return LoadInt(input);
+Node LoadNode(JsonReader& reader) {
+    switch (reader.Peek()) {
+        case '[':
+            return LoadArray(reader);
+        case '{':
+            return LoadDict(reader);
+        case '"':
+            return LoadString(reader);
+        case 't':
+        case 'f':
+            return Node(reader.ReadBool());
+        case 'n':
+            reader.ReadNull();
+            return Node(nullptr);
+        default:
+            return LoadNumber(reader);
+    }
+}
+
+Document Load(string_view input) {
+    JsonReader reader(input);
+    Document doc(LoadNode(reader));
+    if (!reader.AtEnd()) {
+        reader.Fail("Unexpected data after JSON value");
     }
+    return doc;
 }
 
+// Потік зчитується одним блоком, далі розбір іде по буферу
 Document Load(istream& input) {
-    return Document{LoadNode(input)};
+    const string text(std::istreambuf_iterator<char>(input), {});
+    return Load(string_view(text));
 }
@@ -0,0 +1,72 @@
+#pragma once
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Файл, відображений у пам'ять лише для читання; сторінки підвантажуються на вимогу.
+// Без POSIX файл просто читається цілком
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open file " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat file " + path);
+        }
+        size = info.st_size;
+        if (size > 0) {
+            void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not map file " + path);
+            }
+            mapped = static_cast<const char*>(address);
+        }
+        ::close(fd);
+#else
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("Could not open file " + path);
+        }
+        fallback.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        mapped = fallback.data();
+        size = fallback.size();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) {
+            ::munmap(const_cast<char*>(mapped), size);
+        }
+#endif
+    }
+
+    std::string_view Data() const {
+        return {mapped, size};
+    }
+
+private:
+    const char* mapped = nullptr;
+    size_t size = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+    std::string fallback;
+#endif
+};
@@ -1,11 +1,27 @@
 #include "json.h"
+#include "json_arena.h"
+#include "json_binary.h"
+#include "json_bind.h"
+#include "json_parallel.h"
+#include "json_pointer.h"
+#include "json_reader.h"
+#include "json_stream.h"
+#include "json_tape.h"
+#include "json_writer.h"
+#include "mapped_file.h"
 #include "test_runner.h"
 #include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include <fstream>
+#include <iterator>
+#include <map>
 #include <numeric>
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
 
 using namespace std;
 
@@ -22,6 +38,11 @@ ostream& operator << (ostream& os, const Spending& s) {
     return os << '(' << s.category << ": " << s.amount << ')';
 }
 
+JSON_SCHEMA(Spending,
+    JSON_FIELD(Spending, category),
+    JSON_FIELD(Spending, amount)
+)
+
 int CalculateTotalSpendings(const vector<Spending>& spendings) {
     return accumulate(spendings.begin(), spendings.end(), 0,
         [](int total, const Spending& s) {
@@ -52,6 +73,69 @@ vector<Spending> LoadFromJson(istream& input) {
     return result;
 }
 
+// Розбирає один об'єкт витрати прямо з тексту, без дерева Node
+Spending ParseSpending(string_view element) {
+    return DecodeJson<Spending>(element);
+}
+
+// Декодує масив витрат одразу у вектор за схемою Spending
+vector<Spending> LoadFromJsonBound(string_view input) {
+    return DecodeJson<vector<Spending>>(input);
+}
+
+// Викликає callback(Spending) для кожного запису, тримаючи в пам'яті лише один з них
+template <typename Callback>
+void ForEachSpending(istream& input, Callback callback) {
+    ArrayStreamReader reader(input);
+    string_view element;
+    while (reader.Next(element)) {
+        callback(ParseSpending(element));
+    }
+}
+
+// Підсумок витрат: загальна сума, суми за категоріями і найдорожча витрата
+struct SpendingSummary {
+    long long total = 0;
+    size_t count = 0;
+    map<string, long long> by_category;
+    Spending most_expensive{"", 0};
+
+    void Add(const Spending& spending) {
+        total += spending.amount;
+        by_category[spending.category] += spending.amount;
+        // Як і max_element, при рівності лишаємо першу
+        if (count++ == 0 || spending.amount > most_expensive.amount) {
+            most_expensive = spending;
+        }
+    }
+
+    // other описує витрати, що йдуть після поточних
+    void Merge(const SpendingSummary& other) {
+        total += other.total;
+        for (const auto& [category, amount] : other.by_category) {
+            by_category[category] += amount;
+        }
+        if (other.count > 0 && (count == 0 || other.most_expensive.amount > most_expensive.amount)) {
+            most_expensive = other.most_expensive;
+        }
+        count += other.count;
+    }
+};
+
+// Паралельний підсумок масиву витрат без проміжного вектора
+SpendingSummary SummarizeSpendings(string_view json, size_t threads = thread::hardware_concurrency()) {
+    return ParallelReduce<SpendingSummary>(json, threads,
+        [](SpendingSummary& summary, JsonReader& reader) {
+            static thread_local string scratch;
+            Spending spending{"", 0};
+            DecodeValue(reader, spending, scratch);
+            summary.Add(spending);
+        },
+        [](SpendingSummary& summary, const SpendingSummary& other) {
+            summary.Merge(other);
+        });
+}
+
 void TestLoadFromJson() {
     ifstream file("spendings.json");
     if (!file.is_open()) {
@@ -96,9 +180,497 @@ void TestJsonLibrary() {
     ASSERT_EQUAL(array_node.AsArray().size(), 1u);
 }
 
+void TestNodeType() {
+    istringstream json_input(R"({"list": [1, "two"], "empty": {}})");
+    Document doc = Load(json_input);
+    const Node& root = doc.GetRoot();
+
+    ASSERT(root.GetType() == Node::Type::Map);
+    const vector<Node>& list = root.AsMap().at("list").AsArray();
+    ASSERT(list[0].GetType() == Node::Type::Int);
+    ASSERT(list[1].GetType() == Node::Type::String);
+    ASSERT(root.AsMap().at("empty").GetType() == Node::Type::Map);
+
+    try {
+        list[1].AsInt();
+        Assert(false, "AsInt on a string node must throw");
+    } catch (const bad_variant_access&) {
+    }
+}
+
+void TestFullGrammar() {
+    const string text = R"({
+        "negative": -42,
+        "float": 2.5e-1,
+        "big": 12345678901,
+        "flags": [true, false, null],
+        "escaped": "tab\there \"quoted\" \u0416\ud83d\ude00"
+    })";
+    Document doc = Load(string_view(text));
+    const map<string, Node>& root = doc.GetRoot().AsMap();
+
+    ASSERT_EQUAL(root.at("negative").AsInt(), -42);
+    ASSERT(root.at("float").GetType() == Node::Type::Double);
+    ASSERT_EQUAL(root.at("float").AsDouble(), 0.25);
+    ASSERT_EQUAL(root.at("big").AsDouble(), 12345678901.0);
+    const vector<Node>& flags = root.at("flags").AsArray();
+    ASSERT_EQUAL(flags[0].AsBool(), true);
+    ASSERT_EQUAL(flags[1].AsBool(), false);
+    ASSERT(flags[2].IsNull());
+    ASSERT_EQUAL(root.at("escaped").AsString(), "tab\there \"quoted\" \xD0\x96\xF0\x9F\x98\x80");
+}
+
+void TestZeroCopyStrings() {
+    const string text = R"(["plain", "with\nescape"])";
+    JsonReader reader(text);
+    string scratch;
+    reader.Expect('[');
+    string_view plain = reader.ReadString(scratch);
+    ASSERT_EQUAL(plain, "plain");
+    ASSERT(plain.data() >= text.data() && plain.data() < text.data() + text.size());
+    reader.Expect(',');
+    ASSERT_EQUAL(reader.ReadString(scratch), "with\nescape");
+    reader.Expect(']');
+    ASSERT(reader.AtEnd());
+}
+
+void TestParsingErrors() {
+    auto error_position = [](const string& text) {
+        try {
+            Load(string_view(text));
+        } catch (const ParsingError& error) {
+            return to_string(error.Line()) + ":" + to_string(error.Column());
+        }
+        return string("no error");
+    };
+
+    ASSERT_EQUAL(error_position("[1, 2,]"), "1:7");
+    ASSERT_EQUAL(error_position("{\n  \"a\" 1}"), "2:7");
+    ASSERT_EQUAL(error_position("\"open"), "1:6");
+    ASSERT_EQUAL(error_position("[01]"), "1:2");
+    ASSERT_EQUAL(error_position("[1] 2"), "1:5");
+}
+
+void TestStructuralIndexes() {
+    // Екрановані лапки й зворотні косі потрапляють на межі 64-байтових блоків
+    string text = "[";
+    for (int i = 0; i < 40; ++i) {
+        text += "\"" + string(i, 'x') + "\\\\\\\"q\", " + to_string(i) + ", true, ";
+    }
+    text += "{\"k\": [null, -1.5e3]}]";
+
+    const vector<uint32_t> expected = FindStructuralIndexes(text, Stage1Kernel::Scalar);
+    ASSERT_EQUAL(FindStructuralIndexes(text, Stage1Kernel::Sse2), expected);
+    ASSERT_EQUAL(FindStructuralIndexes(text, DetectStage1Kernel()), expected);
+
+    TapeDocument doc(text, Stage1Kernel::Scalar);
+    const TapeValue root = doc.GetRoot();
+    ASSERT_EQUAL(root.Size(), 121u);
+    ASSERT_EQUAL(root[3].AsString(), "x\\\"q");
+    ASSERT_EQUAL(root[4].AsInt(), 1);
+    ASSERT_EQUAL(root[5].AsBool(), true);
+    ASSERT_EQUAL(root[120].At("k")[1].AsDouble(), -1500.0);
+    ASSERT(root[120].At("k")[0].IsNull());
+}
+
+void TestTapeDocument() {
+    ifstream file("spendings.json");
+    const string text(istreambuf_iterator<char>(file), {});
+
+    TapeDocument tape(text);
+    const TapeValue root = tape.GetRoot();
+    ASSERT(root.GetType() == Node::Type::Array);
+    ASSERT_EQUAL(root.Size(), 6u);
+    ASSERT_EQUAL(root[2].At("category").AsString(), "restaurants");
+    ASSERT_EQUAL(root[2].At("amount").AsInt(), 5780);
+
+    Document doc = LoadTape(text);
+    ASSERT_EQUAL(doc.GetRoot().AsArray().back().AsMap().at("category").AsString(), "sport");
+
+    for (const string bad : {"[1, 2", "{\"a\" 1}", "[1 2]", "[tru]", "\"open", "[1]]", "{\"a\":}"}) {
+        try {
+            TapeDocument broken(bad);
+            Assert(false, "Must reject " + bad);
+        } catch (const ParsingError&) {
+        }
+    }
+}
+
+void TestStreamingSpendings() {
+    ifstream file("spendings.json");
+    const vector<Spending> expected = LoadFromJson(file);
+
+    for (size_t chunk_size : {1u, 7u, 64u, 4096u}) {
+        ifstream input("spendings.json");
+        ArrayStreamReader reader(input, chunk_size);
+        vector<Spending> spendings;
+        string_view element;
+        while (reader.Next(element)) {
+            spendings.push_back(ParseSpending(element));
+        }
+        ASSERT_EQUAL(spendings, expected);
+    }
+
+    istringstream mixed(R"([1, "a]\"", {"x": [2, {}]}, [], null])");
+    ArrayStreamReader reader(mixed, 3);
+    vector<string> elements;
+    string_view element;
+    while (reader.Next(element)) {
+        elements.push_back(string(element));
+    }
+    ASSERT_EQUAL(elements, (vector<string>{"1", "\"a]\\\"\"", "{\"x\": [2, {}]}", "[]", "null"}));
+
+    for (const string bad : {"[1, 2", "[1,]", "[1 2]", "{}", "[\"open]", "[1] garbage", "[]\n\n]"}) {
+        istringstream input(bad);
+        ArrayStreamReader broken(input, 2);
+        try {
+            while (broken.Next(element)) {
+            }
+            Assert(false, "Must reject " + bad);
+        } catch (const ParsingError&) {
+        }
+    }
+
+    ifstream input("spendings.json");
+    int total = 0;
+    ForEachSpending(input, [&total](const Spending& spending) {
+        total += spending.amount;
+    });
+    ASSERT_EQUAL(total, CalculateTotalSpendings(expected));
+}
+
+void TestArenaDocument() {
+    ifstream file("spendings.json");
+    const string text(istreambuf_iterator<char>(file), {});
+
+    ArenaDocument doc(text);
+    const ArenaNode& root = doc.GetRoot();
+    ASSERT(root.GetType() == Node::Type::Array);
+    ASSERT_EQUAL(root.Size(), 6u);
+    ASSERT_EQUAL(root[4].At("category").AsString(), "travel");
+    ASSERT_EQUAL(root[4].At("amount").AsInt(), 23740);
+
+    int total = 0;
+    for (const ArenaNode& spending : root) {
+        total += spending.At("amount").AsInt();
+    }
+    ASSERT_EQUAL(total, 52670);
+
+    doc.Parse(R"({"b": [true, null, 1.5], "a": "x\ty", "b": 2, "c": {}})");
+    const ArenaNode& object = doc.GetRoot();
+    ASSERT_EQUAL(object.Size(), 3u);
+    ASSERT_EQUAL(object.MembersBegin()->key, "a");
+    ASSERT_EQUAL(object.At("a").AsString(), "x\ty");
+    ASSERT_EQUAL(object.At("b").Size(), 3u);
+    ASSERT_EQUAL(object.At("b")[0].AsBool(), true);
+    ASSERT(object.At("b")[1].IsNull());
+    ASSERT_EQUAL(object.At("b")[2].AsDouble(), 1.5);
+    ASSERT_EQUAL(object.At("c").Size(), 0u);
+    ASSERT(object.Find("missing") == nullptr);
+}
+
+void TestSchemaBinding() {
+    ifstream file("spendings.json");
+    const string text(istreambuf_iterator<char>(file), {});
+    istringstream input(text);
+    ASSERT_EQUAL(LoadFromJsonBound(text), LoadFromJson(input));
+
+    const Spending spending = ParseSpending(R"({"note": {"skip": [1, "}"]}, "amount": -5, "category": "c\u0430t"})");
+    ASSERT_EQUAL(spending, (Spending{"c\xD0\xB0t", -5}));
+    ASSERT_EQUAL(JsonSchema<Spending>::fields[0].hash, HashKey("category"));
+
+    try {
+        ParseSpending(R"({"amount": 1.5})");
+        Assert(false, "Fractional amount must be rejected");
+    } catch (const ParsingError&) {
+    }
+}
+
+void TestParallelSummary() {
+    {
+        // Рядки з дужками, комами й екранованими лапками не повинні давати хибних меж
+        const vector<string> categories = {"food", R"(a\\\"],[{)", R"(\\\\)", "}, {", "sport"};
+        string json = "[";
+        for (int i = 0; i < 500; ++i) {
+            json += (i ? ",\n" : "") + string("{\"category\": \"") + categories[i % categories.size()] +
+                    "\", \"amount\": " + to_string(i * 37 % 1000) + ", \"tags\": [[1], {\"x\": \"]\"}]}";
+        }
+        json += "]";
+
+        const vector<Spending> spendings = LoadFromJsonBound(json);
+        map<string, long long> by_category;
+        for (const Spending& s : spendings) {
+            by_category[s.category] += s.amount;
+        }
+        for (size_t threads : {1, 2, 3, 8, 64}) {
+            ASSERT(SplitArray(json, threads).size() <= threads);
+            const SpendingSummary summary = SummarizeSpendings(json, threads);
+            ASSERT_EQUAL(summary.count, spendings.size());
+            ASSERT_EQUAL(summary.total, CalculateTotalSpendings(spendings));
+            ASSERT_EQUAL(summary.most_expensive.category, MostExpensiveCategory(spendings));
+            ASSERT_EQUAL(summary.by_category, by_category);
+        }
+        ASSERT_EQUAL(SplitArray(json, 8).size(), 8u);
+    }
+    {
+        ifstream file("spendings.json");
+        const string json{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+        const SpendingSummary summary = SummarizeSpendings(json, 4);
+        ASSERT_EQUAL(summary.total, 52670);
+        ASSERT_EQUAL(summary.most_expensive.category, "travel");
+    }
+    {
+        ASSERT(SplitArray(" [ ] ", 4).empty());
+        ASSERT_EQUAL(SummarizeSpendings("[]", 4).count, 0u);
+    }
+    for (const string bad : {"", "{}", "[", "[{\"amount\": 1}", "[{\"amount\": 1},]", "[,{\"amount\": 1}]",
+                             "[{\"amount\": 1},,{\"amount\": 2}]", "[{\"amount\": 1} {\"amount\": 2}]"}) {
+        for (size_t threads : {1, 3}) {
+            bool thrown = false;
+            try {
+                SummarizeSpendings(bad, threads);
+            } catch (const ParsingError&) {
+                thrown = true;
+            }
+            ASSERT(thrown);
+        }
+    }
+}
+
+void TestSaveJson() {
+    const Document doc = Load(string_view(
+        R"({"list": [1, -2.5, 1e300, 3.0, "a\"b\\c\n\u0001", true, false, null, [], {}], "z": {"k": 0}})"));
+
+    const string compact = SaveToString(doc);
+    ASSERT_EQUAL(compact,
+        R"({"list":[1,-2.5,1e+300,3.0,"a\"b\\c\n\u0001",true,false,null,[],{}],"z":{"k":0}})");
+    ASSERT_EQUAL(SaveToString(Load(string_view(compact))), compact);
+
+    const string pretty = SaveToString(doc, SaveFormat::Pretty);
+    ASSERT_EQUAL(pretty, "{\n"
+        "  \"list\": [\n"
+        "    1,\n"
+        "    -2.5,\n"
+        "    1e+300,\n"
+        "    3.0,\n"
+        "    \"a\\\"b\\\\c\\n\\u0001\",\n"
+        "    true,\n"
+        "    false,\n"
+        "    null,\n"
+        "    [],\n"
+        "    {}\n"
+        "  ],\n"
+        "  \"z\": {\n"
+        "    \"k\": 0\n"
+        "  }\n"
+        "}");
+    ASSERT_EQUAL(SaveToString(Load(string_view(pretty))), compact);
+
+    {
+        // Тип числа зберігається при повторному читанні
+        const Document numbers = Load(SaveToString(Document(Node(vector<Node>{Node(2.0), Node(0.1), Node(7)}))));
+        const vector<Node>& items = numbers.GetRoot().AsArray();
+        ASSERT(items[0].GetType() == Node::Type::Double);
+        ASSERT_EQUAL(items[1].AsDouble(), 0.1);
+        ASSERT(items[2].GetType() == Node::Type::Int);
+    }
+    {
+        bool thrown = false;
+        try {
+            SaveToString(Document(Node(NAN)));
+        } catch (const invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        // Великий документ проходить через кілька скидань буфера
+        vector<Node> items(20000, Node(map<string, Node>{{"category", Node("restaurants")}, {"amount", Node(5780)}}));
+        const Document big(Node(move(items)));
+        ostringstream stream;
+        StreamWriter writer(stream);
+        Save(big, writer);
+        ASSERT_EQUAL(stream.str(), SaveToString(big));
+        ASSERT_EQUAL(Load(string_view(stream.str())).GetRoot().AsArray().size(), 20000u);
+    }
+    {
+        int fds[2];
+        ASSERT(pipe(fds) == 0);
+        FdWriter writer(fds[1]);
+        Save(doc, writer);
+        close(fds[1]);
+        string received;
+        char chunk[256];
+        for (ssize_t n; (n = read(fds[0], chunk, sizeof(chunk))) > 0; ) {
+            received.append(chunk, n);
+        }
+        close(fds[0]);
+        ASSERT_EQUAL(received, compact);
+    }
+}
+
+void TestJsonPointer() {
+    const string json = R"({
+        "spendings": [
+            {"amount": 2500, "category": "food", "tags": [{"x": "]"}]},
+            {"amount": 1150, "category": "tr\"ansport"}
+        ],
+        "a/b": {"c~d": true, "": null},
+        "dup": 1, "dup": 2
+    })";
+
+    ASSERT_EQUAL(Find(json, "/spendings/0/amount").AsInt(), 2500);
+    ASSERT_EQUAL(Find(json, "/spendings/1/category").AsString(), "tr\"ansport");
+    ASSERT_EQUAL(*FindRaw(json, "/spendings/0/tags/0"), R"({"x": "]"})");
+    ASSERT_EQUAL(Find(json, "/a~1b/c~0d").AsBool(), true);
+    ASSERT(Find(json, "/a~1b/").IsNull());
+    ASSERT_EQUAL(Find(json, "/dup").AsInt(), 1);
+    ASSERT_EQUAL(Find(json, "").AsMap().size(), 3u);
+
+    for (const string missing : {"/spendings/2", "/spendings/-", "/spendings/01", "/spendings/x",
+                                 "/spendings/0/amount/0", "/nothing", "/a~1b/c~0d/e"}) {
+        ASSERT(!FindRaw(json, missing));
+        bool thrown = false;
+        try {
+            Find(json, missing);
+        } catch (const out_of_range&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    for (const string bad : {"spendings", "/a~2b"}) {
+        bool thrown = false;
+        try {
+            FindRaw(json, bad);
+        } catch (const invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        bool thrown = false;
+        try {
+            FindRaw(R"({"a": [1, 2})", "/a/5");
+        } catch (const ParsingError&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        // Значення після знайденого не читаються взагалі
+        ASSERT_EQUAL(Find(R"([{"amount": 7}, this is not json)", "/0/amount").AsInt(), 7);
+    }
+}
+
+void TestBinaryJson() {
+    const string json = R"({"list": [1, -2.5, "str", true, false, null, [], {}], "empty": "", "z": {"k": -7}})";
+    const Document doc = Load(string_view(json));
+    const string binary = EncodeBinary(doc);
+
+    BinaryDocument binary_doc(binary);
+    const BinaryValue root = binary_doc.GetRoot();
+    ASSERT(root.GetType() == Node::Type::Map);
+    ASSERT_EQUAL(root.Size(), 3u);
+    ASSERT_EQUAL(root.KeyAt(0), "empty");
+    ASSERT_EQUAL(root.At("empty").AsString(), "");
+    ASSERT_EQUAL(root.At("z").At("k").AsInt(), -7);
+    ASSERT(!root.Contains("missing"));
+
+    const BinaryValue list = root.At("list");
+    ASSERT_EQUAL(list.Size(), 8u);
+    ASSERT_EQUAL(list[0].AsInt(), 1);
+    ASSERT_EQUAL(list[0].AsDouble(), 1.0);
+    ASSERT_EQUAL(list[1].AsDouble(), -2.5);
+    ASSERT_EQUAL(list[2].AsString(), "str");
+    ASSERT(list[3].AsBool() && !list[4].AsBool());
+    ASSERT(list[5].IsNull());
+    ASSERT_EQUAL(list[6].Size(), 0u);
+    ASSERT(list[7].GetType() == Node::Type::Map);
+
+    ASSERT_EQUAL(SaveToString(DecodeBinary(binary)), SaveToString(doc));
+
+    for (auto check : {+[](const BinaryValue& v) { v.At("list")[8]; },
+                       +[](const BinaryValue& v) { v.At("missing"); }}) {
+        bool thrown = false;
+        try {
+            check(root);
+        } catch (const out_of_range&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        bool thrown = false;
+        try {
+            root.At("z").AsInt();
+        } catch (const logic_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        // Єдиний елемент масиву посилається на сам масив
+        string cycle = EncodeBinary(Load(string_view("[0]")));
+        Binary::Header header;
+        memcpy(&header, cycle.data(), sizeof(header));
+        memcpy(cycle.data() + header.root.value + sizeof(uint64_t), &header.root, sizeof(header.root));
+        bool thrown = false;
+        try {
+            DecodeBinary(cycle);
+        } catch (const out_of_range&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    for (const string& bad : {string("JBIN"), string(binary.size(), '\0'), binary.substr(0, binary.size() - 1)}) {
+        bool thrown = false;
+        try {
+            BinaryDocument{bad};
+        } catch (const invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    {
+        // Кешований файл читається через mmap без розбору
+        ifstream file("spendings.json");
+        const Document spendings = Load(file);
+        char path[] = "/tmp/spendingsXXXXXX";
+        const int fd = mkstemp(path);
+        ASSERT(fd >= 0);
+        close(fd);
+        {
+            ofstream output(path, ios::binary);
+            output << EncodeBinary(spendings);
+        }
+        {
+            MappedFile mapped(path);
+            const BinaryValue cached = BinaryDocument(mapped.Data()).GetRoot();
+            ASSERT_EQUAL(cached.Size(), 6u);
+            ASSERT_EQUAL(cached[4].At("category").AsString(), "travel");
+            ASSERT_EQUAL(cached[4].At("amount").AsInt(), 23740);
+        }
+        remove(path);
+    }
+}
+
 int main() {
     TestRunner tr;
     RUN_TEST(tr, TestJsonLibrary);
+    RUN_TEST(tr, TestNodeType);
+    RUN_TEST(tr, TestFullGrammar);
+    RUN_TEST(tr, TestZeroCopyStrings);
+    RUN_TEST(tr, TestParsingErrors);
+    RUN_TEST(tr, TestStructuralIndexes);
+    RUN_TEST(tr, TestTapeDocument);
     RUN_TEST(tr, TestLoadFromJson);
+    RUN_TEST(tr, TestStreamingSpendings);
+    RUN_TEST(tr, TestArenaDocument);
+    RUN_TEST(tr, TestSchemaBinding);
+    RUN_TEST(tr, TestParallelSummary);
+    RUN_TEST(tr, TestSaveJson);
+    RUN_TEST(tr, TestJsonPointer);
+    RUN_TEST(tr, TestBinaryJson);
     return 0;
 }
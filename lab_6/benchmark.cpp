@@ -0,0 +1,136 @@
+#include "ini.h"
+#include "ini_generator.h"
+#include "ini_parallel.h"
+#include "ini_view.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <malloc.h>
+
+using namespace std;
+
+// Лічильники виділень пам'яті для всієї програми: кількість, живі байти і їхній пік.
+// Пік купи не залежить від того, чи glibc повертає звільнене системі, на відміну від RSS
+atomic<size_t> allocations{0};
+atomic<size_t> live_bytes{0};
+atomic<size_t> peak_bytes{0};
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* result = malloc(size ? size : 1)) {
+        const size_t live = live_bytes += malloc_usable_size(result);
+        for (size_t peak = peak_bytes; live > peak && !peak_bytes.compare_exchange_weak(peak, live); ) {
+        }
+        return result;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    live_bytes -= malloc_usable_size(pointer);
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    live_bytes -= malloc_usable_size(pointer);
+    free(pointer);
+}
+
+// Перший запуск рахує виділення і пік купи понад уже зайняте, далі повтори до ~0.3 с для стабільної швидкості.
+// Відображення файлу (MappedDocument) не з купи і в пік не входить
+template <typename Func>
+void Measure(const string& title, size_t bytes, Func func) {
+    const size_t live_before = live_bytes;
+    peak_bytes = live_before;
+    const size_t allocations_before = allocations;
+    func();
+    const size_t allocated = allocations - allocations_before;
+    const size_t heap_peak = peak_bytes - live_before;
+
+    size_t runs = 0;
+    const auto start = chrono::steady_clock::now();
+    chrono::duration<double> elapsed{};
+    do {
+        func();
+        ++runs;
+        elapsed = chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.3);
+
+    cerr << "  " << left << setw(28) << title << right
+         << setw(10) << fixed << setprecision(1) << bytes * runs / elapsed.count() / (1 << 20) << " MB/s"
+         << setw(12) << allocated << " allocs"
+         << setw(10) << heap_peak / 1024 << " KB peak heap" << endl;
+}
+
+string FormatSize(size_t bytes) {
+    if (bytes >= (1 << 30)) {
+        return to_string(bytes >> 30) + " GB";
+    }
+    if (bytes >= (1 << 20)) {
+        return to_string(bytes >> 20) + " MB";
+    }
+    return to_string(bytes >> 10) + " KB";
+}
+
+void BenchmarkCorpus(const string& name, Ini::CorpusOptions options) {
+    const string text = Ini::GenerateIni(options);
+    const string path = "/tmp/ini_benchmark.ini";
+    {
+        ofstream output(path, ios::binary);
+        output << text;
+    }
+    cerr << name << ", " << FormatSize(options.target_bytes) << ":" << endl;
+
+    Measure("Load(ifstream)", text.size(), [&] {
+        ifstream input(path);
+        Ini::Document doc = Ini::Load(input);
+    });
+    Measure("Load(istringstream)", text.size(), [&] {
+        istringstream input(text);
+        Ini::Document doc = Ini::Load(input);
+    });
+    Measure("Load(string_view)", text.size(), [&] {
+        Ini::Document doc = Ini::Load(string_view(text));
+    });
+    const size_t threads = max(1u, thread::hardware_concurrency());
+    Measure("LoadParallel, " + to_string(threads) + " threads", text.size(), [&] {
+        Ini::Document doc = Ini::LoadParallel(text, threads);
+    });
+    Measure("DocumentView(buffer)", text.size(), [&] {
+        Ini::DocumentView view(text);
+    });
+    Measure("MappedDocument(mmap)", text.size(), [&] {
+        Ini::MappedDocument mapped(path);
+    });
+    remove(path.c_str());
+}
+
+// Аргумент - найбільший розмір у МБ (за замовчуванням 64; 1024 дає 1 ГБ)
+int main(int argc, char* argv[]) {
+    const size_t max_bytes = (argc > 1 ? stoul(argv[1]) : 64) << 20;
+
+    for (size_t size = 1 << 10; size <= max_bytes; size *= 16) {
+        Ini::CorpusOptions options;
+        options.target_bytes = size;
+        BenchmarkCorpus("Typical", options);
+
+        options.sections = 10'000;
+        options.keys_per_block = 3;
+        options.key_length = 32;
+        BenchmarkCorpus("Many sections, long keys", options);
+
+        options = {};
+        options.target_bytes = size;
+        options.duplicate_share = 0.3;
+        BenchmarkCorpus("30% duplicate keys", options);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "config_manager.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
+namespace Ini {
+
+namespace {
+
+std::string ReadFile(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Не вдалося відкрити файл: " + path);
+    }
+    return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+}
+
+ConfigManager::Reader::Reader(const ConfigManager& manager)
+    : manager(manager)
+    , version(manager.Version())
+    , document(manager.Current()) {
+}
+
+const Document& ConfigManager::Reader::Get() {
+    const uint64_t latest = manager.Version();
+    if (latest != version) {
+        // Документ може виявитись навіть новішим за latest - тоді наступний виклик просто оновить його ще раз
+        document = manager.Current();
+        version = latest;
+    }
+    return *document;
+}
+
+bool ConfigManager::FileStamp::operator==(const FileStamp& other) const {
+    return time == other.time && size == other.size && inode == other.inode && change_time == other.change_time;
+}
+
+ConfigManager::ConfigManager(std::string path, std::chrono::milliseconds poll_interval)
+    : path(std::move(path))
+    , poll_interval(poll_interval)
+    , stamp(ReadStamp())
+    , loader(ReadFile(this->path)) {
+    Publish(std::make_shared<const Document>(loader.GetDocument()));
+    if (poll_interval.count() > 0) {
+        watcher = std::thread([this] { Watch(); });
+    }
+}
+
+ConfigManager::~ConfigManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stop_signal.notify_all();
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+}
+
+std::shared_ptr<const Document> ConfigManager::Current() const {
+    return std::atomic_load(&current);
+}
+
+uint64_t ConfigManager::Version() const {
+    return version.load(std::memory_order_acquire);
+}
+
+ConfigManager::FileStamp ConfigManager::ReadStamp() const {
+    std::error_code error;
+    FileStamp result;
+    result.time = std::filesystem::last_write_time(path, error);
+    result.size = std::filesystem::file_size(path, error);
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat info;
+    if (::stat(path.c_str(), &info) == 0) {
+        result.inode = info.st_ino;
+#ifdef __APPLE__
+        const timespec changed = info.st_ctimespec;
+#else
+        const timespec changed = info.st_ctim;
+#endif
+        result.change_time = static_cast<std::int64_t>(changed.tv_sec) * 1'000'000'000 + changed.tv_nsec;
+    }
+#endif
+    return result;
+}
+
+void ConfigManager::Publish(std::shared_ptr<const Document> document) {
+    std::atomic_store(&current, std::move(document));
+    version.fetch_add(1, std::memory_order_release);
+}
+
+bool ConfigManager::ReloadNow() {
+    std::lock_guard<std::mutex> reload_lock(reload_mutex);
+    const FileStamp new_stamp = ReadStamp();
+    ConfigDiff diff;
+    try {
+        // Розбір іде без блокування: читачі тим часом бачать попередній документ
+        diff = loader.Reload(ReadFile(path));
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stamp = new_stamp;
+        last_error = e.what();
+        return false;
+    }
+
+    std::vector<std::function<void(const ConfigDiff&)>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stamp = new_stamp;
+        last_error.clear();
+        callbacks = subscribers;
+    }
+    // Зміни лише в порожніх рядках не дають нової версії; нова чи зникла
+    // порожня секція дає, бо її видно через FindSection
+    if (!diff.Empty()) {
+        Publish(std::make_shared<const Document>(loader.GetDocument()));
+        for (const auto& callback : callbacks) {
+            callback(diff);
+        }
+    }
+    return true;
+}
+
+void ConfigManager::Subscribe(std::function<void(const ConfigDiff&)> callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    subscribers.push_back(std::move(callback));
+}
+
+std::string ConfigManager::LastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_error;
+}
+
+void ConfigManager::Watch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop_signal.wait_for(lock, poll_interval, [this] { return stopping; })) {
+        const FileStamp new_stamp = ReadStamp();
+        if (new_stamp == stamp) {
+            continue;
+        }
+        lock.unlock();
+        ReloadNow();
+        lock.lock();
+    }
+}
+
+}
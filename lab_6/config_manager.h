@@ -0,0 +1,96 @@
+#pragma once
+#include "ini.h"
+#include "ini_incremental.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ini {
+
+// Гаряче перезавантаження INI-файлу.
+// Фоновий потік раз на poll_interval перевіряє час зміни, розмір та inode файлу,
+// при зміні перерозбирає змінені секції (IncrementalLoader) і публікує новий документ цілком.
+// Читачі отримують незмінний документ через shared_ptr: старий живе,
+// доки його хтось тримає, тож частково оновленого стану не буває.
+// Файл варто замінювати атомарно (запис у тимчасовий і rename),
+// інакше можна прочитати його на півдорозі запису.
+class ConfigManager {
+public:
+    // Кешує документ для одного потоку: поки версія не змінилась,
+    // Get() - лише одне атомарне читання без блокувань
+    class Reader {
+    public:
+        explicit Reader(const ConfigManager& manager);
+        const Document& Get();
+
+    private:
+        const ConfigManager& manager;
+        uint64_t version;
+        std::shared_ptr<const Document> document;
+    };
+
+    // Перше завантаження синхронне і кидає виключення, якщо файл не читається.
+    // Нульовий інтервал - без фонового потоку, лише ручний ReloadNow()
+    explicit ConfigManager(std::string path,
+                           std::chrono::milliseconds poll_interval = std::chrono::seconds(1));
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+    ~ConfigManager();
+
+    std::shared_ptr<const Document> Current() const;
+    // Зростає з кожним опублікованим документом
+    uint64_t Version() const;
+
+    // Перечитує файл негайно. При помилці лишає попередній документ,
+    // запам'ятовує текст помилки і повертає false
+    bool ReloadNow();
+    std::string LastError() const;
+
+    // callback(diff) викликається після кожної публікації, що щось змінила,
+    // у потоці, який виконав перезавантаження
+    void Subscribe(std::function<void(const ConfigDiff&)> callback);
+
+private:
+    // Заміна через rename за той самий тік годинника з тим самим розміром
+    // не змінює mtime, але завжди дає новий inode
+    struct FileStamp {
+        std::filesystem::file_time_type time;
+        std::uintmax_t size = 0;
+        std::uint64_t inode = 0;
+        std::int64_t change_time = 0;
+        bool operator==(const FileStamp& other) const;
+    };
+
+    FileStamp ReadStamp() const;
+    void Publish(std::shared_ptr<const Document> document);
+    void Watch();
+
+    const std::string path;
+    const std::chrono::milliseconds poll_interval;
+
+    // Доступ лише через std::atomic_load/std::atomic_store
+    std::shared_ptr<const Document> current;
+    std::atomic<uint64_t> version{0};
+
+    // Перезавантаження по черзі, щоб старіший документ не переписав новіший
+    std::mutex reload_mutex;
+    mutable std::mutex mutex;
+    std::condition_variable stop_signal;
+    bool stopping = false;
+    FileStamp stamp;
+    // Змінюється лише під reload_mutex
+    IncrementalLoader loader;
+    std::string last_error;
+    std::vector<std::function<void(const ConfigDiff&)>> subscribers;
+    std::thread watcher;
+};
+
+}
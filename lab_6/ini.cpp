@@ -1,5 +1,7 @@
 #include "ini.h"
+#include <algorithm>
 #include <sstream>
+#include <vector>
 #include <stdexcept>
 
 namespace Ini {
@@ -8,6 +10,21 @@ Section& Document::AddSection(std::string name) {
     return sections[name];
 }
 
+void Document::RemoveSection(const std::string& name) {
+    sections.erase(name);
+}
+
+void Document::Merge(Document&& other) {
+    for (auto& [name, section] : other.sections) {
+        auto [it, inserted] = sections.try_emplace(name, std::move(section));
+        if (!inserted) {
+            // Вузли переносяться без копіювання; наявні ключі лишаються в section
+            it->second.merge(section);
+        }
+    }
+    other.sections.clear();
+}
+
 const Section& Document::GetSection(const std::string& name) const {
     auto it = sections.find(name);
     if (it == sections.end()) {
@@ -16,10 +33,19 @@ const Section& Document::GetSection(const std::string& name) const {
     return it->second;
 }
 
+const Section* Document::FindSection(const std::string& name) const {
+    auto it = sections.find(name);
+    return it == sections.end() ? nullptr : &it->second;
+}
+
 size_t Document::SectionCount() const {
     return sections.size();
 }
 
+const std::unordered_map<std::string, Section>& Document::Sections() const {
+    return sections;
+}
+
 Document Load(std::istream& input) {
     Document doc;
     std::string line;
@@ -55,4 +81,110 @@ Document Load(std::istream& input) {
     return doc;
 }
 
+Document Load(std::string_view text) {
+    Document doc;
+    Section* current_section = nullptr;
+
+    while (!text.empty()) {
+        const size_t line_end = std::min(text.find('\n'), text.size());
+        const std::string_view line = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '[' && line.back() == ']') {
+            current_section = &doc.AddSection(std::string(line.substr(1, line.size() - 2)));
+        } else {
+            if (!current_section) {
+                throw std::logic_error("Пара ключ-значення без секції");
+            }
+
+            auto eq_pos = line.find('=');
+            if (eq_pos == std::string_view::npos) {
+                throw std::logic_error("Неправильна пара ключ-значення: " + std::string(line));
+            }
+
+            current_section->emplace(std::string(line.substr(0, eq_pos)), std::string(line.substr(eq_pos + 1)));
+        }
+    }
+
+    return doc;
+}
+
+bool IsWritableSection(const std::string& name) {
+    return name.find('\n') == std::string::npos;
+}
+
+bool IsWritablePair(const std::string& key, const std::string& value) {
+    if (key.find_first_of("=\n") != std::string::npos || value.find('\n') != std::string::npos) {
+        return false;
+    }
+    // Інакше рядок читався б як заголовок секції
+    return key.empty() || key.front() != '[' || value.empty() || value.back() != ']';
+}
+
+namespace {
+
+const size_t SAVE_BUFFER_SIZE = 64 * 1024;
+
+void CheckSectionName(const std::string& name) {
+    if (!IsWritableSection(name)) {
+        throw std::invalid_argument("Назва секції містить перенос рядка: " + name);
+    }
+}
+
+void CheckPair(const std::string& key, const std::string& value) {
+    if (!IsWritablePair(key, value)) {
+        throw std::invalid_argument("Пару неможливо записати: " + key);
+    }
+}
+
+}
+
+void Save(const Document& doc, std::ostream& output) {
+    std::string buffer;
+    buffer.reserve(SAVE_BUFFER_SIZE);
+    auto flush = [&buffer, &output] {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+    };
+
+    std::vector<const std::pair<const std::string, Section>*> sections;
+    sections.reserve(doc.SectionCount());
+    for (const auto& section : doc.Sections()) {
+        sections.push_back(&section);
+    }
+    auto by_name = [](const auto* lhs, const auto* rhs) {
+        return lhs->first < rhs->first;
+    };
+    std::sort(sections.begin(), sections.end(), by_name);
+
+    std::vector<const std::pair<const std::string, std::string>*> pairs;
+    for (const auto* section : sections) {
+        CheckSectionName(section->first);
+        buffer += '[';
+        buffer += section->first;
+        buffer += "]\n";
+
+        pairs.clear();
+        for (const auto& pair : section->second) {
+            pairs.push_back(&pair);
+        }
+        std::sort(pairs.begin(), pairs.end(), by_name);
+        for (const auto* pair : pairs) {
+            CheckPair(pair->first, pair->second);
+            buffer += pair->first;
+            buffer += '=';
+            buffer += pair->second;
+            buffer += '\n';
+            if (buffer.size() >= SAVE_BUFFER_SIZE) {
+                flush();
+            }
+        }
+    }
+    flush();
+}
+
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <istream>
+#include <ostream>
 
 namespace Ini {
 
@@ -10,13 +12,32 @@ using Section = std::unordered_map<std::string, std::string>;
 class Document {
 public:
     Section& AddSection(std::string name);
+    void RemoveSection(const std::string& name);
+    // Додає секції other так, ніби його текст ішов після поточного:
+    // однакові секції об'єднуються, з повторених ключів лишається наявний
+    void Merge(Document&& other);
     const Section& GetSection(const std::string& name) const;
+    // nullptr, якщо секції немає
+    const Section* FindSection(const std::string& name) const;
     size_t SectionCount() const;
+    const std::unordered_map<std::string, Section>& Sections() const;
 
 private:
     std::unordered_map<std::string, Section> sections;
 };
 
 Document Load(std::istream& input);
+// Те саме для тексту в пам'яті, без построкового копіювання
+Document Load(std::string_view text);
+
+// Чи прочитає Load рядок "[name]" або "key=value" так само, як його записано
+bool IsWritableSection(const std::string& name);
+bool IsWritablePair(const std::string& key, const std::string& value);
+
+// Записує документ через буфер блоками по 64 КБ; секції й ключі впорядковані
+// за назвою, тож вивід детермінований. Рядки, які Load прочитав би інакше
+// (перенос рядка в назві чи значенні, '=' у ключі, пара вигляду "[...]"),
+// кидають std::invalid_argument
+void Save(const Document& doc, std::ostream& output);
 
 }
\ No newline at end of file
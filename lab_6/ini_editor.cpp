@@ -0,0 +1,152 @@
+#include "ini_editor.h"
+#include "ini.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Ini {
+
+namespace {
+
+const size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
+bool IsComment(std::string_view line) {
+    return !line.empty() && (line.front() == ';' || line.front() == '#');
+}
+
+}
+
+Editor::Editor(std::string source) : text(std::move(source)) {
+    const std::string* current = nullptr;
+    size_t offset = 0;
+    while (offset < text.size()) {
+        const size_t line_end = std::min(text.find('\n', offset), text.size());
+        const std::string_view line(text.data() + offset, line_end - offset);
+        const size_t next = std::min(line_end + 1, text.size());
+
+        if (!line.empty() && line.front() == '[' && line.back() == ']') {
+            auto& [name, insertion] = *sections.try_emplace(std::string(line.substr(1, line.size() - 2))).first;
+            // Нові ключі йдуть в останній блок секції
+            insertion.insert_at = next;
+            current = &name;
+        } else if (current && !IsComment(line)) {
+            const size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos) {
+                values.try_emplace({*current, std::string(line.substr(0, eq_pos))},
+                                   offset + eq_pos + 1, line.size() - eq_pos - 1);
+                sections[*current].insert_at = next;
+            }
+        }
+        offset = next;
+    }
+}
+
+void Editor::Set(const std::string& section, const std::string& key, const std::string& value) {
+    if (!IsWritableSection(section) || !IsWritablePair(key, value)) {
+        throw std::invalid_argument("Пару неможливо записати: " + section + "." + key);
+    }
+
+    if (auto it = values.find({section, key}); it != values.end()) {
+        const auto [offset, length] = it->second;
+        patches[offset] = {length, value};
+        return;
+    }
+
+    auto [it, inserted] = sections.try_emplace(section, Insertion{std::string::npos, {}});
+    Insertion& insertion = it->second;
+    if (inserted) {
+        new_sections.push_back(section);
+    }
+    auto pair = std::find_if(insertion.pairs.begin(), insertion.pairs.end(), [&key](const auto& pair) {
+        return pair.first == key;
+    });
+    if (pair != insertion.pairs.end()) {
+        pair->second = value;
+    } else {
+        insertion.pairs.emplace_back(key, value);
+    }
+    if (insertion.insert_at != std::string::npos) {
+        inserted_pairs[insertion.insert_at] = RenderPairs(insertion);
+    }
+}
+
+std::string Editor::RenderPairs(const Insertion& insertion) {
+    std::string result;
+    for (const auto& [key, value] : insertion.pairs) {
+        result += key;
+        result += '=';
+        result += value;
+        result += '\n';
+    }
+    return result;
+}
+
+template <typename Output>
+void Editor::Render(Output output) const {
+    char last = '\n';
+    // Вставка має починатися з нового рядка, навіть якщо файл не закінчується переносом
+    auto write = [&](std::string_view part, bool starts_line) {
+        if (part.empty()) {
+            return;
+        }
+        if (starts_line && last != '\n') {
+            output("\n");
+        }
+        output(part);
+        last = part.back();
+    };
+
+    size_t offset = 0;
+    auto patch = patches.begin();
+    auto insertion = inserted_pairs.begin();
+    while (patch != patches.end() || insertion != inserted_pairs.end()) {
+        // На одній позиції спершу значення: вставка йде вже за ним
+        const bool is_patch = insertion == inserted_pairs.end() ||
+                              (patch != patches.end() && patch->first <= insertion->first);
+        const size_t at = is_patch ? patch->first : insertion->first;
+        write(std::string_view(text).substr(offset, at - offset), false);
+        if (is_patch) {
+            write(patch->second.replacement, false);
+            offset = at + patch->second.length;
+            ++patch;
+        } else {
+            write(insertion->second, true);
+            offset = at;
+            ++insertion;
+        }
+    }
+    write(std::string_view(text).substr(offset), false);
+
+    for (const std::string& name : new_sections) {
+        write("[" + name + "]\n", true);
+        write(RenderPairs(sections.at(name)), true);
+    }
+}
+
+void Editor::WriteTo(std::ostream& output) const {
+    std::string buffer;
+    buffer.reserve(WRITE_BUFFER_SIZE);
+    Render([&](std::string_view part) {
+        if (buffer.size() + part.size() > WRITE_BUFFER_SIZE) {
+            output.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+        if (part.size() >= WRITE_BUFFER_SIZE) {
+            // Великі незмінені відрізки пишуться напряму, без копії в буфер
+            output.write(part.data(), part.size());
+        } else {
+            buffer.append(part);
+        }
+    });
+    output.write(buffer.data(), buffer.size());
+}
+
+std::string Editor::Text() const {
+    std::string result;
+    result.reserve(text.size());
+    Render([&result](std::string_view part) {
+        result.append(part);
+    });
+    return result;
+}
+
+}
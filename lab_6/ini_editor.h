@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Ini {
+
+// Редагування INI-тексту зі збереженням розкладки: коментарів (рядки з ';' чи '#'),
+// порядку, порожніх рядків і всього, чого редактор не розуміє.
+// Вихідний текст не змінюється; кожна правка - латка на відрізок тексту,
+// а вивід збирає незмінені відрізки й латки по порядку.
+//
+// Зміна існуючого ключа замінює лише байти його значення (першого входження,
+// яке й читає Load). Новий ключ дописується після останньої пари останнього
+// блоку секції, нова секція - в кінець файлу.
+class Editor {
+public:
+    explicit Editor(std::string text);
+
+    // Кидає std::invalid_argument для пари, яку Load прочитав би інакше
+    void Set(const std::string& section, const std::string& key, const std::string& value);
+
+    void WriteTo(std::ostream& output) const;
+    std::string Text() const;
+
+private:
+    struct Patch {
+        size_t length;
+        std::string replacement;
+    };
+
+    // Нові пари секції, що вставляються на позиції insert_at
+    struct Insertion {
+        size_t insert_at;
+        std::vector<std::pair<std::string, std::string>> pairs;
+    };
+
+    template <typename Output>
+    void Render(Output output) const;
+    static std::string RenderPairs(const Insertion& insertion);
+
+    std::string text;
+    // Відрізок значення першого входження кожного ключа
+    std::map<std::pair<std::string, std::string>, std::pair<size_t, size_t>> values;
+    std::map<std::string, Insertion> sections;
+    std::vector<std::string> new_sections;
+    // Заміни значень існуючих ключів (довжина може бути нульовою для порожнього значення)
+    std::map<size_t, Patch> patches;
+    // Текст нових пар, що вставляється з нового рядка на позиції
+    std::map<size_t, std::string> inserted_pairs;
+};
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Ini {
+
+// Параметри згенерованого INI-тексту
+struct CorpusOptions {
+    size_t target_bytes = 1 << 20;
+    // Різних назв секцій; блоків більше, ніж назв, тож однакові секції повторюються
+    size_t sections = 100;
+    size_t keys_per_block = 20;
+    size_t key_length = 8;
+    size_t value_length = 16;
+    // Частка пар, що повторюють уже записаний у блоці ключ
+    double duplicate_share = 0.0;
+    uint32_t seed = 42;
+};
+
+// Текст розміром не менше target_bytes, який Load читає без помилок
+inline std::string GenerateIni(const CorpusOptions& options) {
+    static const char ALPHABET[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    std::mt19937 gen(options.seed);
+    std::uniform_int_distribution<size_t> letter(0, sizeof(ALPHABET) - 2);
+    std::bernoulli_distribution duplicate(options.duplicate_share);
+
+    auto random_text = [&](size_t length) {
+        std::string result(length, ' ');
+        for (char& c : result) {
+            c = ALPHABET[letter(gen)];
+        }
+        return result;
+    };
+
+    std::string text;
+    text.reserve(options.target_bytes + 1024);
+    std::vector<std::string> block_keys;
+    for (size_t block = 0; text.size() < options.target_bytes; ++block) {
+        text += "[section" + std::to_string(block % options.sections) + "]\n";
+        block_keys.clear();
+        for (size_t i = 0; i < options.keys_per_block; ++i) {
+            if (!block_keys.empty() && duplicate(gen)) {
+                text += block_keys[gen() % block_keys.size()];
+            } else {
+                block_keys.push_back(random_text(options.key_length));
+                text += block_keys.back();
+            }
+            text += '=';
+            text += random_text(options.value_length);
+            text += '\n';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+}
@@ -0,0 +1,180 @@
+#include "ini_incremental.h"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_set>
+
+namespace Ini {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t HashLine(uint64_t hash, std::string_view line) {
+    for (char c : line) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * FNV_PRIME;
+    }
+    return (hash ^ '\n') * FNV_PRIME;
+}
+
+// Викликає callback(section, line) для кожної пари ключ-значення з тими самими перевірками, що й Load,
+// а on_section(name) - для кожного заголовка
+template <typename OnSection, typename OnPair>
+void ForEachLine(std::string_view text, OnSection on_section, OnPair on_pair) {
+    std::string_view current_section;
+    bool has_section = false;
+    while (!text.empty()) {
+        const size_t line_end = std::min(text.find('\n'), text.size());
+        const std::string_view line = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+
+        if (line.empty()) {
+            continue;
+        }
+        if (line.front() == '[' && line.back() == ']') {
+            current_section = line.substr(1, line.size() - 2);
+            has_section = true;
+            on_section(current_section);
+        } else {
+            if (!has_section) {
+                throw std::logic_error("Пара ключ-значення без секції");
+            }
+            if (line.find('=') == std::string_view::npos) {
+                throw std::logic_error("Неправильна пара ключ-значення: " + std::string(line));
+            }
+            on_pair(current_section, line);
+        }
+    }
+}
+
+// Хеші всіх секцій тексту; ключі - зрізи text
+std::unordered_map<std::string_view, uint64_t> HashSections(std::string_view text) {
+    std::unordered_map<std::string_view, uint64_t> hashes;
+    ForEachLine(text,
+        [&hashes](std::string_view section) {
+            hashes.emplace(section, FNV_OFFSET);
+        },
+        [&hashes](std::string_view section, std::string_view line) {
+            uint64_t& hash = hashes[section];
+            hash = HashLine(hash, line);
+        });
+    return hashes;
+}
+
+// Розбирає лише секції з множини names
+std::unordered_map<std::string, Section> ParseSections(std::string_view text,
+                                                       const std::unordered_set<std::string_view>& names) {
+    std::unordered_map<std::string, Section> result;
+    for (std::string_view name : names) {
+        result[std::string(name)];
+    }
+    Section* current = nullptr;
+    ForEachLine(text,
+        [&](std::string_view section) {
+            auto it = names.count(section) ? result.find(std::string(section)) : result.end();
+            current = it == result.end() ? nullptr : &it->second;
+        },
+        [&](std::string_view, std::string_view line) {
+            if (current) {
+                const size_t eq_pos = line.find('=');
+                current->emplace(std::string(line.substr(0, eq_pos)), std::string(line.substr(eq_pos + 1)));
+            }
+        });
+    return result;
+}
+
+void DiffSections(const std::string& name, const Section& before, const Section& after, ConfigDiff& diff) {
+    for (const auto& [key, value] : after) {
+        auto it = before.find(key);
+        if (it == before.end()) {
+            diff.added.push_back({name, key});
+        } else if (it->second != value) {
+            diff.changed.push_back({name, key});
+        }
+    }
+    for (const auto& [key, value] : before) {
+        if (!after.count(key)) {
+            diff.removed.push_back({name, key});
+        }
+    }
+}
+
+void SortKeys(std::vector<KeyRef>& keys) {
+    std::sort(keys.begin(), keys.end(), [](const KeyRef& lhs, const KeyRef& rhs) {
+        return std::tie(lhs.section, lhs.key) < std::tie(rhs.section, rhs.key);
+    });
+}
+
+}
+
+bool operator==(const KeyRef& lhs, const KeyRef& rhs) {
+    return lhs.section == rhs.section && lhs.key == rhs.key;
+}
+
+std::ostream& operator<<(std::ostream& os, const KeyRef& ref) {
+    return os << ref.section << '.' << ref.key;
+}
+
+bool ConfigDiff::Empty() const {
+    return added.empty() && removed.empty() && changed.empty() &&
+           added_sections.empty() && removed_sections.empty();
+}
+
+IncrementalLoader::IncrementalLoader(std::string_view text) {
+    Reload(text);
+}
+
+ConfigDiff IncrementalLoader::Reload(std::string_view text) {
+    const auto new_hashes = HashSections(text);
+
+    std::unordered_set<std::string_view> changed_names;
+    for (const auto& [name, hash] : new_hashes) {
+        auto it = hashes.find(std::string(name));
+        if (it == hashes.end() || it->second != hash) {
+            changed_names.insert(name);
+        }
+    }
+    auto parsed = ParseSections(text, changed_names);
+
+    ConfigDiff diff;
+    static const Section EMPTY;
+    for (auto& [name, section] : parsed) {
+        const Section* before = doc.FindSection(name);
+        if (!before) {
+            diff.added_sections.push_back(name);
+        }
+        DiffSections(name, before ? *before : EMPTY, section, diff);
+        doc.AddSection(name) = std::move(section);
+        hashes[name] = new_hashes.at(name);
+    }
+    for (auto it = hashes.begin(); it != hashes.end(); ) {
+        if (new_hashes.count(it->first)) {
+            ++it;
+            continue;
+        }
+        DiffSections(it->first, doc.GetSection(it->first), EMPTY, diff);
+        diff.removed_sections.push_back(it->first);
+        doc.RemoveSection(it->first);
+        it = hashes.erase(it);
+    }
+
+    SortKeys(diff.added);
+    SortKeys(diff.removed);
+    SortKeys(diff.changed);
+    std::sort(diff.added_sections.begin(), diff.added_sections.end());
+    std::sort(diff.removed_sections.begin(), diff.removed_sections.end());
+    last_reparsed = parsed.size();
+    return diff;
+}
+
+const Document& IncrementalLoader::GetDocument() const {
+    return doc;
+}
+
+size_t IncrementalLoader::LastReparsedCount() const {
+    return last_reparsed;
+}
+
+}
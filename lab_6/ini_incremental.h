@@ -0,0 +1,54 @@
+#pragma once
+#include "ini.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Ini {
+
+// Ключ, що змінився між двома версіями документа
+struct KeyRef {
+    std::string section;
+    std::string key;
+};
+
+bool operator==(const KeyRef& lhs, const KeyRef& rhs);
+std::ostream& operator<<(std::ostream& os, const KeyRef& ref);
+
+// Різниця між версіями; кожен список відсортований.
+// Нові й зниклі секції перелічені окремо: порожня секція не дає жодного ключа
+struct ConfigDiff {
+    std::vector<KeyRef> added;
+    std::vector<KeyRef> removed;
+    std::vector<KeyRef> changed;
+    std::vector<std::string> added_sections;
+    std::vector<std::string> removed_sections;
+
+    bool Empty() const;
+};
+
+// Документ, що перезавантажується частинами.
+// Для кожної секції зберігається хеш її сирого тексту (усіх блоків з цією назвою
+// по порядку). Reload знову хешує весь текст, але заново розбирає і замінює
+// лише секції з іншим хешем; решта лишається як була.
+class IncrementalLoader {
+public:
+    explicit IncrementalLoader(std::string_view text);
+
+    // Текст перевіряється повністю до будь-яких змін, тож при помилці
+    // (ті самі виключення, що й у Load) документ лишається попереднім
+    ConfigDiff Reload(std::string_view text);
+
+    const Document& GetDocument() const;
+    // Скільки секцій перерозібрано під час останнього Reload
+    size_t LastReparsedCount() const;
+
+private:
+    Document doc;
+    std::unordered_map<std::string, uint64_t> hashes;
+    size_t last_reparsed = 0;
+};
+
+}
@@ -0,0 +1,53 @@
+#include "ini_parallel.h"
+#include <algorithm>
+#include <future>
+#include <vector>
+
+namespace Ini {
+
+namespace {
+
+// Початок першого рядка-заголовка не раніше from, або text.size()
+size_t FindSectionStart(std::string_view text, size_t from) {
+    if (from > 0) {
+        // Межа має припадати на початок рядка
+        const size_t line_end = text.find('\n', from - 1);
+        from = line_end == std::string_view::npos ? text.size() : line_end + 1;
+    }
+    while (from < text.size()) {
+        const size_t line_end = std::min(text.find('\n', from), text.size());
+        if (line_end > from && text[from] == '[' && text[line_end - 1] == ']') {
+            return from;
+        }
+        from = line_end + 1;
+    }
+    return text.size();
+}
+
+}
+
+Document LoadParallel(std::string_view text, size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    std::vector<size_t> bounds = {0};
+    for (size_t i = 1; i < threads; ++i) {
+        const size_t start = FindSectionStart(text, text.size() * i / threads);
+        if (start > bounds.back() && start < text.size()) {
+            bounds.push_back(start);
+        }
+    }
+    bounds.push_back(text.size());
+
+    std::vector<std::future<Document>> parts;
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        parts.push_back(std::async(std::launch::async, [text, begin = bounds[i], end = bounds[i + 1]] {
+            return Load(text.substr(begin, end - begin));
+        }));
+    }
+    Document result = Load(text.substr(0, bounds[1]));
+    for (auto& part : parts) {
+        result.Merge(part.get());
+    }
+    return result;
+}
+
+}
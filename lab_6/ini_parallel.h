@@ -0,0 +1,16 @@
+#pragma once
+#include "ini.h"
+#include <string_view>
+#include <thread>
+
+namespace Ini {
+
+// Паралельне завантаження великого тексту.
+// Текст ділиться на шматки по рядках-заголовках "[...]" (лише від заголовка
+// пара знає свою секцію), шматки розбираються в окремих потоках у часткові
+// документи, які зливаються по порядку: як і в Load, однакові секції
+// об'єднуються, а з повторених ключів лишається перший.
+// Помилки ті самі, що й у Load; якщо їх кілька, кидається перша за текстом
+Document LoadParallel(std::string_view text, size_t threads = std::thread::hardware_concurrency());
+
+}
@@ -0,0 +1,145 @@
+#include "ini_snapshot.h"
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+namespace Ini {
+
+namespace {
+
+template <typename Number>
+Number ParseNumber(std::string_view text) {
+    Number value{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || error != std::errc() || end != text.data() + text.size()) {
+        throw std::invalid_argument("Неправильне число: " + std::string(text));
+    }
+    return value;
+}
+
+bool ParseBool(std::string_view text) {
+    if (text == "true" || text == "1" || text == "yes" || text == "on") {
+        return true;
+    }
+    if (text == "false" || text == "0" || text == "no" || text == "off") {
+        return false;
+    }
+    throw std::invalid_argument("Неправильне логічне значення: " + std::string(text));
+}
+
+std::chrono::milliseconds ParseDuration(std::string_view text) {
+    const size_t unit_pos = text.find_first_not_of("0123456789");
+    if (unit_pos == 0 || unit_pos == std::string_view::npos) {
+        throw std::invalid_argument("Тривалість без числа або одиниці: " + std::string(text));
+    }
+    const int64_t count = ParseNumber<int64_t>(text.substr(0, unit_pos));
+    const std::string_view unit = text.substr(unit_pos);
+    if (unit == "ms") {
+        return std::chrono::milliseconds(count);
+    }
+    if (unit == "s") {
+        return std::chrono::seconds(count);
+    }
+    if (unit == "m") {
+        return std::chrono::minutes(count);
+    }
+    if (unit == "h") {
+        return std::chrono::hours(count);
+    }
+    throw std::invalid_argument("Невідома одиниця тривалості: " + std::string(text));
+}
+
+}
+
+Snapshot::Value ParseValue(std::string_view text, ValueType type) {
+    switch (type) {
+        case ValueType::String:
+            return std::string(text);
+        case ValueType::Int:
+            return ParseNumber<int64_t>(text);
+        case ValueType::Double:
+            return ParseNumber<double>(text);
+        case ValueType::Bool:
+            return ParseBool(text);
+        case ValueType::Duration:
+            return ParseDuration(text);
+    }
+    throw std::logic_error("Невідомий тип значення");
+}
+
+Snapshot::Snapshot(std::vector<Value> values) : values(std::move(values)) {
+}
+
+const std::string& Snapshot::GetString(Key key) const {
+    return std::get<std::string>(values.at(key.index));
+}
+
+int64_t Snapshot::GetInt(Key key) const {
+    return std::get<int64_t>(values.at(key.index));
+}
+
+double Snapshot::GetDouble(Key key) const {
+    return std::get<double>(values.at(key.index));
+}
+
+bool Snapshot::GetBool(Key key) const {
+    return std::get<bool>(values.at(key.index));
+}
+
+std::chrono::milliseconds Snapshot::GetDuration(Key key) const {
+    return std::get<std::chrono::milliseconds>(values.at(key.index));
+}
+
+Key SnapshotSchema::Declare(std::string section, std::string key, ValueType type,
+                            std::optional<std::string> default_value) {
+    if (default_value) {
+        // Помилку в значенні за замовчуванням краще побачити одразу, а не при першому Compile
+        ParseValue(*default_value, type);
+    }
+    fields.push_back({std::move(section), std::move(key), type, std::move(default_value)});
+    return {static_cast<uint32_t>(fields.size() - 1), type};
+}
+
+template <typename Lookup>
+Snapshot SnapshotSchema::CompileWith(Lookup lookup) const {
+    std::vector<Snapshot::Value> values;
+    values.reserve(fields.size());
+    for (const Field& field : fields) {
+        std::optional<std::string_view> text = lookup(field.section, field.key);
+        if (!text) {
+            if (!field.default_value) {
+                throw std::invalid_argument("Відсутній ключ: " + field.section + "." + field.key);
+            }
+            text = *field.default_value;
+        }
+        try {
+            values.push_back(ParseValue(*text, field.type));
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(field.section + "." + field.key + ": " + e.what());
+        }
+    }
+    return Snapshot(std::move(values));
+}
+
+Snapshot SnapshotSchema::Compile(const Document& doc) const {
+    return CompileWith([&doc](const std::string& section, const std::string& key) -> std::optional<std::string_view> {
+        const Section* found = doc.FindSection(section);
+        if (!found) {
+            return std::nullopt;
+        }
+        auto it = found->find(key);
+        if (it == found->end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    });
+}
+
+Snapshot SnapshotSchema::Compile(const DocumentView& doc) const {
+    return CompileWith([&doc](const std::string& section, const std::string& key) -> std::optional<std::string_view> {
+        const SectionView* found = doc.FindSection(section);
+        return found ? found->Find(key) : std::nullopt;
+    });
+}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "ini.h"
+#include "ini_view.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Ini {
+
+enum class ValueType {
+    String,
+    Int,
+    Double,
+    // true/false, 1/0, yes/no, on/off
+    Bool,
+    // Число з одиницею: 250ms, 5s, 2m, 1h
+    Duration,
+};
+
+// Дескриптор ключа: номер слота в знімку і очікуваний тип
+struct Key {
+    uint32_t index;
+    ValueType type;
+};
+
+// Незмінний знімок конфігурації: значення розібрані наперед, доступ - індексація масиву.
+// Звернення дескриптором іншого типу кидає std::bad_variant_access,
+// дескриптором іншої схеми поза межами знімка - std::out_of_range
+class Snapshot {
+public:
+    using Value = std::variant<std::string, int64_t, double, bool, std::chrono::milliseconds>;
+
+    const std::string& GetString(Key key) const;
+    int64_t GetInt(Key key) const;
+    double GetDouble(Key key) const;
+    bool GetBool(Key key) const;
+    std::chrono::milliseconds GetDuration(Key key) const;
+
+private:
+    friend class SnapshotSchema;
+    explicit Snapshot(std::vector<Value> values);
+
+    std::vector<Value> values;
+};
+
+// Перелік потрібних ключів. Дескриптори видаються один раз при старті
+// й лишаються дійсними для всіх знімків, скомпільованих за цією схемою
+class SnapshotSchema {
+public:
+    // default_value розбирається так само, як значення з файлу; без нього ключ обов'язковий
+    Key Declare(std::string section, std::string key, ValueType type,
+                std::optional<std::string> default_value = std::nullopt);
+
+    // Кидає std::invalid_argument, якщо обов'язкового ключа немає або значення не того типу
+    Snapshot Compile(const Document& doc) const;
+    Snapshot Compile(const DocumentView& doc) const;
+
+private:
+    struct Field {
+        std::string section;
+        std::string key;
+        ValueType type;
+        std::optional<std::string> default_value;
+    };
+
+    template <typename Lookup>
+    Snapshot CompileWith(Lookup lookup) const;
+
+    std::vector<Field> fields;
+};
+
+// Розбирає текст значення у вказаний тип; кидає std::invalid_argument
+Snapshot::Value ParseValue(std::string_view text, ValueType type);
+
+}
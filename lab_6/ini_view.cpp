@@ -0,0 +1,136 @@
+#include "ini_view.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Ini {
+
+SectionView::SectionView(std::string_view name, const EntryView* first, const EntryView* last)
+    : name(name)
+    , first(first)
+    , last(last) {
+}
+
+std::string_view SectionView::Name() const {
+    return name;
+}
+
+size_t SectionView::Size() const {
+    return last - first;
+}
+
+std::optional<std::string_view> SectionView::Find(std::string_view key) const {
+    auto it = std::lower_bound(first, last, key, [](const EntryView& entry, std::string_view key) {
+        return entry.key < key;
+    });
+    if (it == last || it->key != key) {
+        return std::nullopt;
+    }
+    return it->value;
+}
+
+std::string_view SectionView::At(std::string_view key) const {
+    if (auto value = Find(key)) {
+        return *value;
+    }
+    throw std::out_of_range("Ключ не знайдений: " + std::string(key));
+}
+
+const EntryView* SectionView::begin() const {
+    return first;
+}
+
+const EntryView* SectionView::end() const {
+    return last;
+}
+
+DocumentView::DocumentView(std::string_view text) {
+    // Кількість рядків - верхня межа кількості пар, тож вектор не перевиділяється
+    entries.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+    std::vector<std::string_view> names;
+    std::string_view current_section;
+    bool has_section = false;
+
+    while (!text.empty()) {
+        const size_t line_end = std::min(text.find('\n'), text.size());
+        const std::string_view line = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+
+        // Ігнорування порожних рядків
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '[' && line.back() == ']') {
+            current_section = line.substr(1, line.size() - 2);
+            has_section = true;
+            names.push_back(current_section);
+        } else {
+            if (!has_section) {
+                throw std::logic_error("Пара ключ-значення без секції");
+            }
+            auto eq_pos = line.find('=');
+            if (eq_pos == std::string_view::npos) {
+                throw std::logic_error("Неправильна пара ключ-значення: " + std::string(line));
+            }
+            entries.push_back({current_section, line.substr(0, eq_pos), line.substr(eq_pos + 1)});
+        }
+    }
+
+    // Стійке сортування лишає першим перше входження ключа, як emplace у Load
+    std::stable_sort(entries.begin(), entries.end(), [](const EntryView& lhs, const EntryView& rhs) {
+        return lhs.section != rhs.section ? lhs.section < rhs.section : lhs.key < rhs.key;
+    });
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const EntryView& lhs, const EntryView& rhs) {
+        return lhs.section == rhs.section && lhs.key == rhs.key;
+    }), entries.end());
+
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    sections.reserve(names.size());
+    const EntryView* first = entries.data();
+    const EntryView* const end = entries.data() + entries.size();
+    for (std::string_view name : names) {
+        const EntryView* last = std::find_if(first, end, [name](const EntryView& entry) {
+            return entry.section != name;
+        });
+        sections.emplace_back(name, first, last);
+        first = last;
+    }
+}
+
+const SectionView* DocumentView::FindSection(std::string_view name) const {
+    auto it = std::lower_bound(sections.begin(), sections.end(), name,
+        [](const SectionView& section, std::string_view name) {
+            return section.Name() < name;
+        });
+    if (it == sections.end() || it->Name() != name) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+const SectionView& DocumentView::GetSection(std::string_view name) const {
+    if (const SectionView* section = FindSection(name)) {
+        return *section;
+    }
+    throw std::out_of_range("Секція не знайдена: " + std::string(name));
+}
+
+size_t DocumentView::SectionCount() const {
+    return sections.size();
+}
+
+const std::vector<SectionView>& DocumentView::Sections() const {
+    return sections;
+}
+
+MappedDocument::MappedDocument(const std::string& path)
+    : file(path)
+    , view(file.Data()) {
+}
+
+const DocumentView& MappedDocument::View() const {
+    return view;
+}
+
+}
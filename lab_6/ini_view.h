@@ -0,0 +1,76 @@
+#pragma once
+#include "ini.h"
+#include "mapped_file.h"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Ini {
+
+// Пара ключ-значення як зрізи вхідного буфера
+struct EntryView {
+    std::string_view section;
+    std::string_view key;
+    std::string_view value;
+};
+
+// Пари однієї секції, відсортовані за ключем
+class SectionView {
+public:
+    SectionView(std::string_view name, const EntryView* first, const EntryView* last);
+
+    std::string_view Name() const;
+    size_t Size() const;
+    std::optional<std::string_view> Find(std::string_view key) const;
+    // Кидає std::out_of_range, якщо ключа немає
+    std::string_view At(std::string_view key) const;
+
+    const EntryView* begin() const;
+    const EntryView* end() const;
+
+private:
+    std::string_view name;
+    const EntryView* first;
+    const EntryView* last;
+};
+
+// Розбір INI без копіювання рядків: секції й пари зберігаються у двох
+// відсортованих пласких векторах зрізів тексту, пошук - двійковий.
+// Правила ті самі, що й у Load: порожні рядки пропускаються, при повторі
+// ключа лишається перше значення, однакові секції зливаються.
+// Текст має жити, доки використовується DocumentView
+class DocumentView {
+public:
+    explicit DocumentView(std::string_view text);
+    // Секції посилаються на внутрішній вектор пар, тож копіювати не можна
+    DocumentView(const DocumentView&) = delete;
+    DocumentView& operator=(const DocumentView&) = delete;
+    DocumentView(DocumentView&&) = default;
+    DocumentView& operator=(DocumentView&&) = default;
+
+    // Кидає std::out_of_range, якщо секції немає
+    const SectionView& GetSection(std::string_view name) const;
+    const SectionView* FindSection(std::string_view name) const;
+    size_t SectionCount() const;
+
+    // Секції в порядку зростання назв
+    const std::vector<SectionView>& Sections() const;
+
+private:
+    std::vector<EntryView> entries;
+    std::vector<SectionView> sections;
+};
+
+// Відображає файл у пам'ять і розбирає його без копіювання
+class MappedDocument {
+public:
+    explicit MappedDocument(const std::string& path);
+    const DocumentView& View() const;
+
+private:
+    MappedFile file;
+    DocumentView view;
+};
+
+}
@@ -1,6 +1,18 @@
+#include "config_manager.h"
 #include "ini.h"
+#include "ini_editor.h"
+#include "ini_generator.h"
+#include "ini_incremental.h"
+#include "ini_parallel.h"
+#include "ini_snapshot.h"
+#include "ini_view.h"
 #include "test_runner.h"
 #include <sstream>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unistd.h>
 
 using namespace Ini;
 
@@ -57,11 +69,463 @@ void TestDuplicateSections() {
     ASSERT_EQUAL(doc.GetSection("section1").at("key2"), "value2");
 }
 
+void TestDocumentView() {
+    const std::string text =
+        "[section1]\n"
+        "key2=value2\n"
+        "key1=value1\n"
+        "key1=ignored\n"
+        "\n"
+        "[empty]\n"
+        "[section2]\n"
+        "key3=a=b\n"
+        "[section1]\n"
+        "key0=\n"
+        "key2=ignored";
+
+    DocumentView view(text);
+    ASSERT_EQUAL(view.SectionCount(), 3u);
+    const SectionView& section1 = view.GetSection("section1");
+    ASSERT_EQUAL(section1.Size(), 3u);
+    ASSERT_EQUAL(section1.At("key0"), "");
+    ASSERT_EQUAL(section1.At("key1"), "value1");
+    ASSERT_EQUAL(section1.At("key2"), "value2");
+    ASSERT_EQUAL(view.GetSection("section2").At("key3"), "a=b");
+    ASSERT_EQUAL(view.GetSection("empty").Size(), 0u);
+    ASSERT(!section1.Find("key3"));
+    ASSERT(view.FindSection("missing") == nullptr);
+
+    // Значення - зрізи вихідного тексту
+    const std::string_view value = section1.At("key1");
+    ASSERT(value.data() >= text.data() && value.data() < text.data() + text.size());
+
+    try {
+        view.GetSection("missing");
+        Assert(false, "Очікувалась виключна ситуація для неіснуючої секції");
+    } catch (const std::out_of_range&) {
+    }
+    for (const std::string bad : {"key=value\n", "[s]\nno separator\n"}) {
+        try {
+            DocumentView{bad};
+            Assert(false, "Очікувалась виключна ситуація для " + bad);
+        } catch (const std::logic_error&) {
+        }
+    }
+}
+
+void TestDocumentViewMatchesLoad() {
+    std::mt19937 gen(7);
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        if (gen() % 10 == 0) {
+            text += "[s" + std::to_string(gen() % 20) + "]\n";
+        } else if (gen() % 20 == 0) {
+            text += "\n";
+        } else if (!text.empty()) {
+            text += "k" + std::to_string(gen() % 50) + "=" + std::to_string(gen()) + "\n";
+        }
+    }
+    text = "[s0]\n" + text;
+
+    std::istringstream input(text);
+    const Document doc = Load(input);
+    DocumentView view(text);
+    ASSERT_EQUAL(view.SectionCount(), doc.SectionCount());
+    for (const SectionView& section : view.Sections()) {
+        const Section& expected = doc.GetSection(std::string(section.Name()));
+        ASSERT_EQUAL(section.Size(), expected.size());
+        for (const EntryView& entry : section) {
+            ASSERT_EQUAL(entry.value, expected.at(std::string(entry.key)));
+        }
+    }
+
+    char path[] = "/tmp/iniXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT(fd >= 0);
+    close(fd);
+    {
+        std::ofstream output(path);
+        output << text;
+    }
+    {
+        MappedDocument mapped(path);
+        ASSERT_EQUAL(mapped.View().SectionCount(), doc.SectionCount());
+        ASSERT_EQUAL(mapped.View().GetSection("s0").Size(), doc.GetSection("s0").size());
+    }
+    std::remove(path);
+}
+
+void TestSnapshot() {
+    const std::string text =
+        "[server]\n"
+        "port=8080\n"
+        "ratio=0.75\n"
+        "verbose=on\n"
+        "timeout=5s\n"
+        "name=front\n"
+        "[bad]\n"
+        "port=80x\n";
+
+    SnapshotSchema schema;
+    const Key port = schema.Declare("server", "port", ValueType::Int);
+    const Key ratio = schema.Declare("server", "ratio", ValueType::Double);
+    const Key verbose = schema.Declare("server", "verbose", ValueType::Bool);
+    const Key timeout = schema.Declare("server", "timeout", ValueType::Duration);
+    const Key name = schema.Declare("server", "name", ValueType::String);
+    const Key retries = schema.Declare("server", "retries", ValueType::Int, "3");
+    const Key idle = schema.Declare("client", "idle", ValueType::Duration, "250ms");
+
+    std::istringstream input(text);
+    const Snapshot snapshot = schema.Compile(Load(input));
+    ASSERT_EQUAL(snapshot.GetInt(port), 8080);
+    ASSERT_EQUAL(snapshot.GetDouble(ratio), 0.75);
+    ASSERT(snapshot.GetBool(verbose));
+    ASSERT(snapshot.GetDuration(timeout) == std::chrono::seconds(5));
+    ASSERT_EQUAL(snapshot.GetString(name), "front");
+    ASSERT_EQUAL(snapshot.GetInt(retries), 3);
+    ASSERT(snapshot.GetDuration(idle) == std::chrono::milliseconds(250));
+
+    // Ті самі дескриптори працюють і для знімка з DocumentView
+    DocumentView view(text);
+    ASSERT_EQUAL(schema.Compile(view).GetInt(port), 8080);
+
+    try {
+        snapshot.GetInt(ratio);
+        Assert(false, "Очікувалась виключна ситуація для іншого типу");
+    } catch (const std::bad_variant_access&) {
+    }
+    try {
+        snapshot.GetString(Key{100, ValueType::String});
+        Assert(false, "Очікувалась виключна ситуація для дескриптора іншої схеми");
+    } catch (const std::out_of_range&) {
+    }
+
+    SnapshotSchema bad_value;
+    bad_value.Declare("bad", "port", ValueType::Int);
+    SnapshotSchema missing;
+    missing.Declare("server", "absent", ValueType::String);
+    for (const SnapshotSchema* invalid : {&bad_value, &missing}) {
+        try {
+            invalid->Compile(view);
+            Assert(false, "Очікувалась виключна ситуація при компіляції");
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    for (auto [value, type] : {std::pair{"", ValueType::Int}, {"1.5", ValueType::Int}, {"maybe", ValueType::Bool},
+                               {"5", ValueType::Duration}, {"5d", ValueType::Duration}, {"ms", ValueType::Duration}}) {
+        try {
+            ParseValue(value, type);
+            Assert(false, std::string("Очікувалась виключна ситуація для ") + value);
+        } catch (const std::invalid_argument&) {
+        }
+    }
+}
+
+void TestConfigManager() {
+    char path[] = "/tmp/configXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT(fd >= 0);
+    close(fd);
+    // Файл підміняється атомарно через rename, як і має робити той, хто змінює конфігурацію
+    auto write_file = [&path](const std::string& text) {
+        const std::string temporary = std::string(path) + ".tmp";
+        {
+            std::ofstream output(temporary, std::ios::trunc);
+            output << text;
+        }
+        std::rename(temporary.c_str(), path);
+    };
+
+    write_file("[server]\nport=80\n");
+    {
+        ConfigManager manager(path, std::chrono::milliseconds(0));
+        ConfigManager::Reader reader(manager);
+        std::vector<KeyRef> changed;
+        manager.Subscribe([&changed](const ConfigDiff& diff) {
+            changed.insert(changed.end(), diff.changed.begin(), diff.changed.end());
+        });
+        const auto first = manager.Current();
+        ASSERT_EQUAL(reader.Get().GetSection("server").at("port"), "80");
+
+        write_file("[server]\nport=8080\n");
+        ASSERT(manager.ReloadNow());
+        ASSERT_EQUAL(reader.Get().GetSection("server").at("port"), "8080");
+        ASSERT_EQUAL(changed, (std::vector<KeyRef>{{"server", "port"}}));
+        // Старий документ лишається цілим, доки його тримають
+        ASSERT_EQUAL(first->GetSection("server").at("port"), "80");
+
+        // Зламаний файл не замінює робочий документ
+        const uint64_t version = manager.Version();
+        write_file("port=1\n");
+        ASSERT(!manager.ReloadNow());
+        ASSERT(!manager.LastError().empty());
+        ASSERT_EQUAL(manager.Version(), version);
+        ASSERT_EQUAL(reader.Get().GetSection("server").at("port"), "8080");
+
+        // Порожня секція без ключів теж публікується
+        write_file("[server]\nport=8080\n[feature]\n");
+        ASSERT(manager.ReloadNow());
+        ASSERT(reader.Get().FindSection("feature") != nullptr);
+        write_file("[server]\nport=8080\n");
+        ASSERT(manager.ReloadNow());
+        ASSERT(reader.Get().FindSection("feature") == nullptr);
+        ASSERT_EQUAL(changed, (std::vector<KeyRef>{{"server", "port"}}));
+    }
+
+    write_file("[server]\nport=1\ncopy=1\n");
+    {
+        ConfigManager manager(path, std::chrono::milliseconds(5));
+        std::atomic<bool> done = false;
+        std::atomic<bool> consistent = true;
+        // Читач у паралельному потоці завжди бачить повний документ
+        std::thread reader_thread([&] {
+            ConfigManager::Reader reader(manager);
+            while (!done) {
+                const Document& doc = reader.Get();
+                const Section& server = doc.GetSection("server");
+                if (server.at("port") != server.at("copy")) {
+                    consistent = false;
+                }
+            }
+        });
+        write_file("[server]\nport=2\ncopy=2\n");
+        for (int i = 0; i < 400 && manager.Current()->GetSection("server").at("port") != "2"; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        done = true;
+        reader_thread.join();
+        ASSERT(consistent);
+        ASSERT_EQUAL(manager.Current()->GetSection("server").at("port"), "2");
+
+        // Та сама довжина і той самий mtime: зміну видно лише з inode
+        const auto time = std::filesystem::last_write_time(path);
+        write_file("[server]\nport=3\ncopy=3\n");
+        std::filesystem::last_write_time(path, time);
+        for (int i = 0; i < 400 && manager.Current()->GetSection("server").at("port") != "3"; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ASSERT_EQUAL(manager.Current()->GetSection("server").at("port"), "3");
+    }
+    std::remove(path);
+}
+
+void TestIncrementalReload() {
+    IncrementalLoader loader(
+        "[a]\n"
+        "x=1\n"
+        "y=2\n"
+        "[b]\n"
+        "z=3\n"
+        "[a]\n"
+        "w=4\n"
+        "[c]\n"
+        "k=5\n"
+    );
+    ASSERT_EQUAL(loader.GetDocument().SectionCount(), 3u);
+    ASSERT_EQUAL(loader.GetDocument().GetSection("a").at("w"), "4");
+    const Section* untouched = &loader.GetDocument().GetSection("b");
+
+    ConfigDiff diff = loader.Reload(
+        "[a]\n"
+        "x=1\n"
+        "y=20\n"
+        "[b]\n"
+        "z=3\n"
+        "[a]\n"
+        "v=6\n"
+        "[d]\n"
+        "n=7\n"
+    );
+    ASSERT_EQUAL(loader.LastReparsedCount(), 2u);
+    ASSERT_EQUAL(diff.added, (std::vector<KeyRef>{{"a", "v"}, {"d", "n"}}));
+    ASSERT_EQUAL(diff.removed, (std::vector<KeyRef>{{"a", "w"}, {"c", "k"}}));
+    ASSERT_EQUAL(diff.changed, (std::vector<KeyRef>{{"a", "y"}}));
+    ASSERT_EQUAL(diff.added_sections, (std::vector<std::string>{"d"}));
+    ASSERT_EQUAL(diff.removed_sections, (std::vector<std::string>{"c"}));
+    // Незмінена секція не перебудовувалась
+    ASSERT(&loader.GetDocument().GetSection("b") == untouched);
+    ASSERT(loader.GetDocument().FindSection("c") == nullptr);
+
+    // Документ дорівнює повному розбору нового тексту
+    std::istringstream input("[a]\nx=1\ny=20\n[b]\nz=3\n[a]\nv=6\n[d]\nn=7\n");
+    const Document expected = Load(input);
+    for (const std::string name : {"a", "b", "d"}) {
+        ASSERT_EQUAL(loader.GetDocument().GetSection(name), expected.GetSection(name));
+    }
+    ASSERT_EQUAL(loader.GetDocument().SectionCount(), expected.SectionCount());
+
+    // Помилка не змінює документ
+    try {
+        loader.Reload("[a]\nx=2\nbroken\n");
+        Assert(false, "Очікувалась виключна ситуація для зламаного тексту");
+    } catch (const std::logic_error&) {
+    }
+    ASSERT_EQUAL(loader.GetDocument().GetSection("a").at("x"), "1");
+
+    // Порожні рядки пропускаються ще до хешування: хеші ті самі, нічого не перерозбирається
+    ASSERT(loader.Reload("[a]\nx=1\ny=20\n\n[b]\nz=3\n[a]\nv=6\n[d]\nn=7\n").Empty());
+    ASSERT_EQUAL(loader.LastReparsedCount(), 0u);
+}
+
+void TestSave() {
+    Document doc;
+    doc.AddSection("b")["y"] = "2";
+    doc.AddSection("b")["x"] = "a=b";
+    doc.AddSection("a")["key"] = "";
+    doc.AddSection("empty");
+
+    std::ostringstream output;
+    Save(doc, output);
+    ASSERT_EQUAL(output.str(), "[a]\nkey=\n[b]\nx=a=b\ny=2\n[empty]\n");
+
+    std::istringstream input(output.str());
+    const Document loaded = Load(input);
+    ASSERT_EQUAL(loaded.SectionCount(), 3u);
+    ASSERT_EQUAL(loaded.GetSection("b"), doc.GetSection("b"));
+
+    for (auto [key, value] : {std::pair{"k=", "v"}, {"k", "line\nbreak"}, {"[k", "v]"}}) {
+        Document bad;
+        bad.AddSection("s")[key] = value;
+        std::ostringstream ignored;
+        try {
+            Save(bad, ignored);
+            Assert(false, std::string("Очікувалась виключна ситуація для ключа ") + key);
+        } catch (const std::invalid_argument&) {
+        }
+    }
+}
+
+void TestEditor() {
+    const std::string text =
+        "; головний сервер\n"
+        "[server]\n"
+        "port=80\n"
+        "# вимкнено: host=old\n"
+        "host=example.com\n"
+        "\n"
+        "[client]\n"
+        "retries=3\n"
+        "[server]\n"
+        "port=81\n"
+        "extra=1\n"
+        "\n"
+        "; кінець";
+
+    Editor editor(text);
+    ASSERT_EQUAL(editor.Text(), text);
+
+    editor.Set("server", "port", "8080");
+    editor.Set("server", "host", "");
+    editor.Set("server", "timeout", "5s");
+    editor.Set("server", "timeout", "10s");
+    editor.Set("client", "retries", "5");
+    editor.Set("client", "backoff", "on");
+    editor.Set("new", "key", "value");
+    editor.Set("new", "other", "1");
+
+    const std::string expected =
+        "; головний сервер\n"
+        "[server]\n"
+        "port=8080\n"
+        "# вимкнено: host=old\n"
+        "host=\n"
+        "\n"
+        "[client]\n"
+        "retries=5\n"
+        "backoff=on\n"
+        "[server]\n"
+        "port=81\n"
+        "extra=1\n"
+        "timeout=10s\n"
+        "\n"
+        "; кінець\n"
+        "[new]\n"
+        "key=value\n"
+        "other=1\n";
+    ASSERT_EQUAL(editor.Text(), expected);
+
+    std::ostringstream output;
+    editor.WriteTo(output);
+    ASSERT_EQUAL(output.str(), expected);
+
+    try {
+        editor.Set("server", "bad=key", "1");
+        Assert(false, "Очікувалась виключна ситуація для ключа з '='");
+    } catch (const std::invalid_argument&) {
+    }
+
+    // Секція без пар, що закінчує файл без переносу рядка
+    Editor tail("[a]\nx=1\n[b]");
+    tail.Set("b", "y", "2");
+    tail.Set("a", "x", "3");
+    ASSERT_EQUAL(tail.Text(), "[a]\nx=3\n[b]\ny=2\n");
+
+    // Заміна порожнього значення не переносить його на новий рядок
+    Editor empty("[a]\nk=\nz=1\n");
+    empty.Set("a", "k", "v");
+    ASSERT_EQUAL(empty.Text(), "[a]\nk=v\nz=1\n");
+
+    // Порожнє значення в кінці файлу і вставка нової пари на тій самій позиції
+    Editor last("[a]\nk=");
+    last.Set("a", "k", "v");
+    last.Set("a", "n", "2");
+    ASSERT_EQUAL(last.Text(), "[a]\nk=v\nn=2\n");
+    std::istringstream reloaded(last.Text());
+    ASSERT_EQUAL(Load(reloaded).GetSection("a").at("k"), "v");
+}
+
+void TestLoadParallel() {
+    CorpusOptions options;
+    options.target_bytes = 128 * 1024;
+    options.sections = 7;
+    options.keys_per_block = 12;
+    options.key_length = 2;
+    options.duplicate_share = 0.2;
+    const std::string text = "\n" + GenerateIni(options);
+
+    std::istringstream input(text);
+    const Document expected = Load(input);
+    for (size_t threads : {1, 2, 3, 8, 1000}) {
+        const Document doc = LoadParallel(text, threads);
+        ASSERT_EQUAL(doc.SectionCount(), expected.SectionCount());
+        for (const auto& [name, section] : expected.Sections()) {
+            ASSERT_EQUAL(doc.GetSection(name), section);
+        }
+    }
+
+    {
+        const std::string duplicates = "[a]\nx=1\n[b]\ny=2\n[a]\nx=2\nz=3\n";
+        const Document doc = LoadParallel(duplicates, 3);
+        ASSERT_EQUAL(doc.GetSection("a").at("x"), "1");
+        ASSERT_EQUAL(doc.GetSection("a").at("z"), "3");
+    }
+    ASSERT_EQUAL(LoadParallel("", 4).SectionCount(), 0u);
+
+    // Перша за текстом помилка, як у послідовному Load
+    const std::string broken = "x=1\n[a]\nbad\n";
+    for (size_t threads : {1, 4}) {
+        try {
+            LoadParallel(broken, threads);
+            Assert(false, "Очікувалась виключна ситуація для пари без секції");
+        } catch (const std::logic_error& e) {
+            ASSERT_EQUAL(std::string(e.what()), "Пара ключ-значення без секції");
+        }
+    }
+}
+
 int main() {
     TestRunner tr;
     RUN_TEST(tr, TestLoadIni);
     RUN_TEST(tr, TestDocument);
     RUN_TEST(tr, TestUnknownSection);
     RUN_TEST(tr, TestDuplicateSections);
+    RUN_TEST(tr, TestDocumentView);
+    RUN_TEST(tr, TestDocumentViewMatchesLoad);
+    RUN_TEST(tr, TestSnapshot);
+    RUN_TEST(tr, TestConfigManager);
+    RUN_TEST(tr, TestIncrementalReload);
+    RUN_TEST(tr, TestSave);
+    RUN_TEST(tr, TestEditor);
+    RUN_TEST(tr, TestLoadParallel);
     return 0;
 }
\ No newline at end of file
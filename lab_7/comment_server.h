@@ -0,0 +1,100 @@
+#pragma once
+#include "http.h"
+#include "http_parser.h"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+struct LastCommentInfo {
+    size_t user_id, consecutive_count;
+};
+
+class CommentServer {
+public:
+    HttpResponse ServeRequest(const HttpRequest& req) {
+        const auto user_id = req.get_params.find("user_id");
+        return Serve(req.method, req.path, req.body,
+                     user_id == req.get_params.end() ? std::nullopt : std::optional<std::string_view>(user_id->second));
+    }
+
+    // Запит прямо з буфера з'єднання: рядки запиту не копіюються
+    HttpResponse ServeRequest(const HttpRequestView& req) {
+        return Serve(req.method, req.path, req.body, req.GetParam("user_id"));
+    }
+
+private:
+    HttpResponse Serve(std::string_view method, std::string_view path, std::string_view body,
+                       std::optional<std::string_view> user_id) {
+        if (method == "POST") {
+            if (path == "/add_user") {
+                return ServeAddUser();
+            } else if (path == "/add_comment") {
+                return ServeAddComment(body);
+            } else if (path == "/check_captcha") {
+                return ServeCheckCaptcha(body);
+            }
+        } else if (method == "GET") {
+            if (path == "/user_comments") {
+                // Без user_id - виключення, як і від at() раніше
+                return ServeUserComments(user_id.value());
+            } else if (path == "/captcha") {
+                return ServeCaptcha();
+            }
+        }
+        return HttpResponse(HttpCode::NotFound);
+    }
+
+    HttpResponse ServeAddUser() {
+        comments_.emplace_back();
+        return HttpResponse(HttpCode::Ok).SetContent(std::to_string(comments_.size() - 1));
+    }
+
+    HttpResponse ServeAddComment(std::string_view body) {
+        auto [user_id, comment] = ParseIdAndContent(body);
+        if (!last_comment || last_comment->user_id != user_id) {
+            last_comment = {user_id, 1};
+        } else if (++last_comment->consecutive_count > 3) {
+            banned_users.insert(user_id);
+        }
+
+        if (banned_users.count(user_id) == 0) {
+            // at(): номер користувача тепер приходить з мережі
+            comments_.at(user_id).emplace_back(comment);
+            return HttpResponse(HttpCode::Ok);
+        } else {
+            return HttpResponse(HttpCode::Found).AddHeader("Location", "/captcha");
+        }
+    }
+
+    HttpResponse ServeCheckCaptcha(std::string_view body) {
+        auto [id, response] = ParseIdAndContent(body);
+        if (response == "42") {
+            banned_users.erase(id);
+            return HttpResponse(HttpCode::Ok);
+        }
+        return HttpResponse(HttpCode::Found).AddHeader("Location", "/captcha");
+    }
+
+    HttpResponse ServeUserComments(std::string_view user_id_text) {
+        const size_t user_id = ParseId(user_id_text);
+        std::string response;
+        for (const auto& comment : comments_.at(user_id)) {
+            response += comment;
+            response += '\n';
+        }
+        return HttpResponse(HttpCode::Ok).SetContent(std::move(response));
+    }
+
+    HttpResponse ServeCaptcha() {
+        // Незмінна відповідь: байти для мережі готуються один раз
+        static const StaticResponse captcha(HttpResponse(HttpCode::Ok)
+            .SetContent("What's the answer for The Ultimate Question of Life, the Universe, and Everything?"));
+        return HttpResponse(captcha);
+    }
+
+    std::vector<std::vector<std::string>> comments_;
+    std::optional<LastCommentInfo> last_comment;
+    std::unordered_set<size_t> banned_users;
+};
@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class HttpCode {
+    Ok = 200,
+    NotFound = 404,
+    Found = 302,
+    BadRequest = 400,
+};
+
+// Код разом з текстом статусу, як у рядку відповіді
+inline const char* StatusText(HttpCode code) {
+    switch (code) {
+        case HttpCode::Ok:
+            return "200 OK";
+        case HttpCode::Found:
+            return "302 Found";
+        case HttpCode::NotFound:
+            return "404 Not found";
+        case HttpCode::BadRequest:
+            return "400 Bad request";
+        default:
+            throw std::invalid_argument("Unknown HTTP code");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& output, HttpCode code) {
+    return output << StatusText(code);
+}
+
+struct HttpHeader {
+    std::string name, value;
+};
+
+inline bool operator==(const HttpHeader& lhs, const HttpHeader& rhs) {
+    return lhs.name == rhs.name && lhs.value == rhs.value;
+}
+
+inline std::ostream& operator<<(std::ostream& output, const HttpHeader& header) {
+    return output << header.name << ": " << header.value;
+}
+
+class StaticResponse;
+
+class HttpResponse {
+public:
+    explicit HttpResponse(HttpCode code) : code(code) {}
+    // Посилається на готову відповідь без копіювання; prepared має жити довше.
+    // Перша зміна робить власну копію
+    explicit HttpResponse(const StaticResponse& prepared) : prepared(&prepared) {}
+    // Тимчасова готова відповідь зникла б раніше за посилання на неї
+    HttpResponse(const StaticResponse&&) = delete;
+
+    HttpResponse& AddHeader(std::string name, std::string value) {
+        Detach();
+        headers.push_back({std::move(name), std::move(value)});
+        return *this;
+    }
+
+    HttpResponse& SetContent(std::string content) {
+        Detach();
+        this->content = std::move(content);
+        return *this;
+    }
+
+    HttpResponse& SetCode(HttpCode code) {
+        Detach();
+        this->code = code;
+        return *this;
+    }
+
+    HttpCode GetCode() const;
+    const std::vector<HttpHeader>& GetHeaders() const;
+    const std::string& GetContent() const;
+
+    // Готова відповідь, на яку посилається ця, або nullptr
+    const StaticResponse* GetPrepared() const {
+        return prepared;
+    }
+
+    bool operator==(const HttpResponse& other) const {
+        return GetCode() == other.GetCode() &&
+               GetHeaders() == other.GetHeaders() &&
+               GetContent() == other.GetContent();
+    }
+
+    friend std::ostream& operator<<(std::ostream& output, const HttpResponse& resp) {
+        output << "HTTP/1.1 " << resp.GetCode() << "\n";
+        for (const auto& header : resp.GetHeaders()) {
+            output << header << "\n";
+        }
+        if (!resp.GetContent().empty()) {
+            output << "Content-Length: " << resp.GetContent().size() << "\n";
+        }
+        return output << "\n" << resp.GetContent();
+    }
+
+private:
+    void Detach();
+
+    HttpCode code = HttpCode::Ok;
+    std::vector<HttpHeader> headers;
+    std::string content;
+    const StaticResponse* prepared = nullptr;
+};
+
+// Рядок статусу й заголовки у форматі для мережі (CRLF, завжди Content-Length)
+// без тіла. output не очищується, тож один буфер можна використовувати повторно
+inline void AppendResponseHead(const HttpResponse& response, bool keep_alive, std::string& output) {
+    output += "HTTP/1.1 ";
+    output += StatusText(response.GetCode());
+    output += "\r\n";
+    for (const auto& header : response.GetHeaders()) {
+        output += header.name;
+        output += ": ";
+        output += header.value;
+        output += "\r\n";
+    }
+    // Без довжини клієнт не знав би, де кінець відповіді на живому з'єднанні
+    char length[20];
+    const auto result = std::to_chars(length, length + sizeof(length), response.GetContent().size());
+    output += "Content-Length: ";
+    output.append(length, result.ptr);
+    output += "\r\n";
+    if (!keep_alive) {
+        output += "Connection: close\r\n";
+    }
+    output += "\r\n";
+}
+
+// Відповідь, наперед перетворена в байти для мережі в обох варіантах Connection.
+// Для незмінних відповідей: надсилається як є, без форматування й копіювання тіла
+class StaticResponse {
+public:
+    explicit StaticResponse(HttpResponse response) : source(std::move(response)) {
+        for (bool keep_alive : {true, false}) {
+            std::string& bytes = keep_alive ? keep_alive_bytes : close_bytes;
+            AppendResponseHead(source, keep_alive, bytes);
+            bytes += source.GetContent();
+        }
+    }
+    StaticResponse(const StaticResponse&) = delete;
+    StaticResponse& operator=(const StaticResponse&) = delete;
+
+    const HttpResponse& Source() const {
+        return source;
+    }
+
+    std::string_view Bytes(bool keep_alive) const {
+        return keep_alive ? keep_alive_bytes : close_bytes;
+    }
+
+private:
+    HttpResponse source;
+    std::string keep_alive_bytes;
+    std::string close_bytes;
+};
+
+inline HttpCode HttpResponse::GetCode() const {
+    return prepared ? prepared->Source().GetCode() : code;
+}
+
+inline const std::vector<HttpHeader>& HttpResponse::GetHeaders() const {
+    return prepared ? prepared->Source().GetHeaders() : headers;
+}
+
+inline const std::string& HttpResponse::GetContent() const {
+    return prepared ? prepared->Source().GetContent() : content;
+}
+
+inline void HttpResponse::Detach() {
+    if (prepared) {
+        code = prepared->Source().GetCode();
+        headers = prepared->Source().GetHeaders();
+        content = prepared->Source().GetContent();
+        prepared = nullptr;
+    }
+}
+
+// Повна відповідь для мережі; готова відповідь копіюється одним блоком
+inline void AppendHttpResponse(const HttpResponse& response, bool keep_alive, std::string& output) {
+    if (const StaticResponse* prepared = response.GetPrepared()) {
+        output += prepared->Bytes(keep_alive);
+        return;
+    }
+    AppendResponseHead(response, keep_alive, output);
+    output += response.GetContent();
+}
+
+struct HttpRequest {
+    std::string method, path, body;
+    std::map<std::string, std::string> get_params;
+};
+
+inline std::pair<std::string, std::string> SplitBy(const std::string& what, const std::string& by) {
+    size_t pos = what.find(by);
+    if (by.size() < what.size() && pos < what.size() - by.size()) {
+        return {what.substr(0, pos), what.substr(pos + by.size())};
+    } else {
+        return {what, {}};
+    }
+}
+
+template<typename T>
+T FromString(const std::string& s) {
+    T x;
+    std::istringstream is(s);
+    is >> x;
+    return x;
+}
+
+// Число без знаку на весь рядок; інше кидає std::invalid_argument
+inline size_t ParseId(std::string_view text) {
+    size_t id = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), id);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        throw std::invalid_argument("Invalid id");
+    }
+    return id;
+}
+
+// "<id> <текст>": текст - зріз body до кінця, без копіювання
+inline std::pair<size_t, std::string_view> ParseIdAndContent(std::string_view body) {
+    const size_t space = std::min(body.find(' '), body.size());
+    return {ParseId(body.substr(0, space)), body.substr(std::min(space + 1, body.size()))};
+}
@@ -0,0 +1,202 @@
+#include "http_parser.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+
+using std::string;
+using std::string_view;
+
+namespace {
+
+constexpr size_t MAX_HEADER_SIZE = 64 * 1024;
+constexpr size_t MAX_BODY_SIZE = 1024 * 1024;
+
+bool EqualsIgnoreCase(string_view lhs, string_view rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+string_view Trim(string_view text) {
+    const size_t begin = text.find_first_not_of(" \t");
+    if (begin == string_view::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+}
+
+// Наступний рядок заголовка без CRLF (або LF); зсуває data за нього
+string_view NextLine(string_view& data) {
+    const size_t end = std::min(data.find('\n'), data.size());
+    string_view line = data.substr(0, end);
+    data.remove_prefix(std::min(end + 1, data.size()));
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+}
+
+std::optional<string_view> HttpRequestView::GetParam(string_view name) const {
+    for (size_t i = 0; i < param_count; ++i) {
+        if (params[i].name == name) {
+            return params[i].value;
+        }
+    }
+    return std::nullopt;
+}
+
+HttpRequest ToRequest(const HttpRequestView& view) {
+    HttpRequest request;
+    request.method = string(view.method);
+    request.path = string(view.path);
+    request.body = string(view.body);
+    for (size_t i = 0; i < view.param_count; ++i) {
+        request.get_params.emplace(string(view.params[i].name), string(view.params[i].value));
+    }
+    return request;
+}
+
+size_t HttpRequestParser::Parse(string_view data, HttpRequestView& request) {
+    if (header_end == 0) {
+        if (!FindHeaderEnd(data)) {
+            if (data.size() > MAX_HEADER_SIZE) {
+                throw std::invalid_argument("Request header is too large");
+            }
+            return 0;
+        }
+        ParseHead(data);
+    }
+    if (data.size() - header_end < content_length) {
+        return 0;
+    }
+
+    const auto slice = [data](Span span) {
+        return data.substr(span.begin, span.size);
+    };
+    request.method = slice(method);
+    request.path = slice(path);
+    request.body = data.substr(header_end, content_length);
+    request.param_count = param_count;
+    for (size_t i = 0; i < param_count; ++i) {
+        request.params[i] = {slice(params[i].first), slice(params[i].second)};
+    }
+    request.keep_alive = keep_alive;
+
+    const size_t size = header_end + content_length;
+    Reset();
+    return size;
+}
+
+void HttpRequestParser::Reset() {
+    *this = HttpRequestParser();
+}
+
+bool HttpRequestParser::FindHeaderEnd(string_view data) {
+    if (!started) {
+        // Порожні рядки перед запитом дозволені RFC 7230
+        const size_t start = data.find_first_not_of("\r\n");
+        if (start == string_view::npos) {
+            return false;
+        }
+        started = true;
+        scanned = start;
+    }
+    // scanned - позиція, з якої ще може початися кінець заголовків
+    while (true) {
+        const size_t newline = data.find('\n', scanned);
+        if (newline == string_view::npos) {
+            scanned = std::max(scanned, data.size());
+            return false;
+        }
+        scanned = newline;
+        if (newline + 1 < data.size() && data[newline + 1] == '\n') {
+            header_end = newline + 2;
+            return true;
+        }
+        if (newline + 2 < data.size() && data[newline + 1] == '\r' && data[newline + 2] == '\n') {
+            header_end = newline + 3;
+            return true;
+        }
+        if (newline + 2 >= data.size()) {
+            return false;
+        }
+        scanned = newline + 1;
+    }
+}
+
+void HttpRequestParser::ParseHead(string_view data) {
+    const size_t start = data.find_first_not_of("\r\n");
+    string_view head = data.substr(start, header_end - start);
+    const string_view request_line = NextLine(head);
+    const size_t line_begin = request_line.data() - data.data();
+    const size_t first_space = request_line.find(' ');
+    const size_t last_space = request_line.rfind(' ');
+    if (first_space == string_view::npos || first_space == last_space) {
+        throw std::invalid_argument("Malformed request line");
+    }
+    const string_view version = request_line.substr(last_space + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        throw std::invalid_argument("Unsupported HTTP version");
+    }
+
+    method = {line_begin, first_space};
+    ParseTarget(data, {line_begin + first_space + 1, last_space - first_space - 1});
+    keep_alive = version == "HTTP/1.1";
+
+    bool has_content_length = false;
+    while (!head.empty()) {
+        const string_view line = NextLine(head);
+        if (line.empty()) {
+            continue;
+        }
+        const size_t colon = line.find(':');
+        if (colon == string_view::npos) {
+            throw std::invalid_argument("Malformed header");
+        }
+        const string_view name = line.substr(0, colon);
+        const string_view value = Trim(line.substr(colon + 1));
+        if (EqualsIgnoreCase(name, "Content-Length")) {
+            size_t length = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), length);
+            if (error != std::errc() || end != value.data() + value.size() || length > MAX_BODY_SIZE) {
+                throw std::invalid_argument("Invalid Content-Length");
+            }
+            // Різні довжини в одному запиті - ознака підміни запиту (RFC 7230, 3.3.2)
+            if (has_content_length && length != content_length) {
+                throw std::invalid_argument("Conflicting Content-Length");
+            }
+            has_content_length = true;
+            content_length = length;
+        } else if (EqualsIgnoreCase(name, "Connection")) {
+            if (EqualsIgnoreCase(value, "close")) {
+                keep_alive = false;
+            } else if (EqualsIgnoreCase(value, "keep-alive")) {
+                keep_alive = true;
+            }
+        } else if (EqualsIgnoreCase(name, "Transfer-Encoding")) {
+            throw std::invalid_argument("Transfer-Encoding is not supported");
+        }
+    }
+}
+
+void HttpRequestParser::ParseTarget(string_view data, Span target) {
+    const string_view text = data.substr(target.begin, target.size);
+    const size_t query_pos = std::min(text.find('?'), text.size());
+    path = {target.begin, query_pos};
+
+    size_t pos = query_pos + 1;
+    while (pos < text.size()) {
+        const size_t amp = std::min(text.find('&', pos), text.size());
+        // Параметри понад MAX_PARAMS відкидаються
+        if (amp > pos && param_count < params.size()) {
+            const size_t eq = std::min(text.find('=', pos), amp);
+            const size_t value_begin = std::min(eq + 1, amp);
+            params[param_count++] = {{target.begin + pos, eq - pos},
+                                     {target.begin + value_begin, amp - value_begin}};
+        }
+        pos = amp + 1;
+    }
+}
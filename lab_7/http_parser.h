@@ -0,0 +1,64 @@
+#pragma once
+#include "http.h"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+struct HttpParam {
+    std::string_view name;
+    std::string_view value;
+};
+
+// Запит без копіювання: усі поля - зрізи буфера, з якого його розібрано,
+// і живуть, доки цей буфер не змінюється.
+// Зберігаються лише перші MAX_PARAMS параметрів запиту, решта ігнорується
+struct HttpRequestView {
+    static constexpr size_t MAX_PARAMS = 16;
+
+    std::string_view method;
+    std::string_view path;
+    std::string_view body;
+    std::array<HttpParam, MAX_PARAMS> params;
+    size_t param_count = 0;
+    bool keep_alive = true;
+
+    // Перший параметр запиту з таким ім'ям
+    std::optional<std::string_view> GetParam(std::string_view name) const;
+};
+
+// Копія у звичайний HttpRequest для коду, що працює з власними рядками
+HttpRequest ToRequest(const HttpRequestView& view);
+
+// Покроковий розбір HTTP/1.x з часткового буфера з'єднання за один прохід.
+// data щоразу має починатися з початку запиту і між викликами лише доповнюватись
+// (адреса буфера може змінитися: стан зберігається як зсуви).
+// Вже переглянуті байти повторно не скануються, пам'ять не виділяється.
+// Зламаний або завеликий запит кидає std::invalid_argument
+class HttpRequestParser {
+public:
+    // Кількість байтів запиту, коли він повний (request заповнено, парсер готовий
+    // до наступного запиту), або 0, якщо потрібні ще дані
+    size_t Parse(std::string_view data, HttpRequestView& request);
+    void Reset();
+
+private:
+    struct Span {
+        size_t begin;
+        size_t size;
+    };
+
+    bool FindHeaderEnd(std::string_view data);
+    void ParseHead(std::string_view data);
+    void ParseTarget(std::string_view data, Span target);
+
+    bool started = false;
+    size_t scanned = 0;
+    size_t header_end = 0;
+    size_t content_length = 0;
+    bool keep_alive = true;
+    Span method{};
+    Span path{};
+    std::array<std::pair<Span, Span>, HttpRequestView::MAX_PARAMS> params{};
+    size_t param_count = 0;
+};
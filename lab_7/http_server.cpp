@@ -0,0 +1,380 @@
+#include "http_server.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using std::string;
+using std::string_view;
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;
+// Поки стільки відповідей не відправлено, нові запити з'єднання не читаються
+constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+// Коротші тіла дешевше скопіювати до заголовків, ніж відправляти окремим шматком
+constexpr size_t MAX_INLINE_CONTENT = 512;
+// Шматків за один sendmsg (IOV_MAX у Linux - 1024)
+constexpr size_t MAX_IOVECS = 64;
+// Відправлений початок heads звільняється, коли він не менший за цей розмір
+constexpr size_t MIN_HEADS_COMPACTION = 64 * 1024;
+
+[[noreturn]] void ThrowSystemError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+}
+
+size_t ParseHttpRequest(string_view data, HttpRequest& request, bool& keep_alive) {
+    HttpRequestParser parser;
+    HttpRequestView view;
+    const size_t size = parser.Parse(data, view);
+    if (size > 0) {
+        request = ToRequest(view);
+        keep_alive = view.keep_alive;
+    }
+    return size;
+}
+
+HttpServer::HttpServer(Handler handler, const string& host, uint16_t port)
+    : handler(std::move(handler)) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        throw std::invalid_argument("Invalid IPv4 address: " + host);
+    }
+
+    listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        ThrowSystemError("socket");
+    }
+    const int enable = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    if (bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd, SOMAXCONN) != 0) {
+        const int error = errno;
+        close(listen_fd);
+        errno = error;
+        ThrowSystemError("bind/listen");
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &length);
+    this->port = ntohs(address.sin_port);
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        const int error = errno;
+        close(listen_fd);
+        close(epoll_fd);
+        close(wake_fd);
+        errno = error;
+        ThrowSystemError("epoll/eventfd");
+    }
+    for (int fd : {listen_fd, wake_fd}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+    reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+}
+
+HttpServer::~HttpServer() {
+    for (const auto& [fd, connection] : connections) {
+        close(fd);
+    }
+    close(listen_fd);
+    close(epoll_fd);
+    close(wake_fd);
+    if (reserve_fd >= 0) {
+        close(reserve_fd);
+    }
+}
+
+uint16_t HttpServer::Port() const {
+    return port;
+}
+
+void HttpServer::Stop() {
+    const uint64_t one = 1;
+    // eventfd лише накопичує лічильник, тож повторний виклик безпечний
+    [[maybe_unused]] const ssize_t written = write(wake_fd, &one, sizeof(one));
+}
+
+void HttpServer::Run() {
+    epoll_event events[256];
+    while (true) {
+        const int count = epoll_wait(epoll_fd, events, std::size(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowSystemError("epoll_wait");
+        }
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd) {
+                uint64_t value;
+                [[maybe_unused]] const ssize_t received = read(wake_fd, &value, sizeof(value));
+                return;
+            }
+            if (fd == listen_fd) {
+                AcceptAll();
+            } else {
+                OnEvent(fd, events[i].events);
+            }
+        }
+    }
+}
+
+void HttpServer::AcceptAll() {
+    while (true) {
+        const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if ((errno == EMFILE || errno == ENFILE) && reserve_fd >= 0) {
+                // Дескриптори скінчились, а з'єднання лишається в черзі, тож рівневий epoll
+                // будив би цикл без кінця. Запасний дескриптор дає прийняти й одразу закрити його.
+                // Лише одне за подію: accept повертає EMFILE і з порожньою чергою,
+                // а решту черги epoll поверне наступною подією
+                close(reserve_fd);
+                const int rejected = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (rejected >= 0) {
+                    close(rejected);
+                }
+                reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                return;
+            }
+            if (errno == ECONNABORTED || errno == EINTR) {
+                continue;
+            }
+            // EAGAIN - черга порожня; інші помилки не зупиняють сервер
+            return;
+        }
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        connections.emplace(fd, Connection{});
+    }
+}
+
+void HttpServer::OnEvent(int fd, uint32_t events) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& connection = it->second;
+
+    if (events & EPOLLERR) {
+        Close(fd);
+        return;
+    }
+    if (connection.reading && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) {
+        // Один блок за подію: рівневі події повернуть решту, а інші з'єднання не чекатимуть
+        const size_t old_size = connection.input.size();
+        connection.input.resize(old_size + READ_CHUNK);
+        const ssize_t received = read(fd, connection.input.data() + old_size, READ_CHUNK);
+        connection.input.resize(old_size + std::max<ssize_t>(received, 0));
+        if (received == 0) {
+            // Клієнт більше нічого не надішле; відповідаємо на вже отримане і закриваємо
+            connection.close_after_write = true;
+            connection.reading = false;
+        } else if (received < 0 && errno != EAGAIN && errno != EINTR) {
+            Close(fd);
+            return;
+        }
+        ProcessRequests(connection);
+    }
+    if (Flush(fd, connection)) {
+        UpdateEvents(fd, connection);
+    }
+}
+
+void HttpServer::ProcessRequests(Connection& connection) {
+    size_t consumed = 0;
+    while (connection.reading || connection.close_after_write) {
+        if (connection.pending > MAX_PENDING_OUTPUT) {
+            break;
+        }
+        HttpRequestView request;
+        size_t size;
+        try {
+            size = connection.parser.Parse(string_view(connection.input).substr(consumed), request);
+        } catch (const std::invalid_argument&) {
+            Enqueue(connection, HttpResponse(HttpCode::BadRequest), false);
+            connection.close_after_write = true;
+            connection.reading = false;
+            consumed = connection.input.size();
+            break;
+        }
+        if (size == 0) {
+            break;
+        }
+        consumed += size;
+
+        HttpResponse response(HttpCode::BadRequest);
+        try {
+            response = handler(request);
+        } catch (const std::exception&) {
+        }
+        Enqueue(connection, std::move(response), request.keep_alive);
+        if (!request.keep_alive) {
+            connection.close_after_write = true;
+            connection.reading = false;
+            consumed = connection.input.size();
+            break;
+        }
+    }
+    connection.input.erase(0, consumed);
+}
+
+void HttpServer::Enqueue(Connection& connection, HttpResponse response, bool keep_alive) {
+    if (const StaticResponse* prepared = response.GetPrepared()) {
+        const string_view bytes = prepared->Bytes(keep_alive);
+        connection.chunks.push_back({bytes.data(), 0, bytes.size(), false});
+        connection.pending += bytes.size();
+        return;
+    }
+
+    const size_t begin = connection.heads.size();
+    AppendResponseHead(response, keep_alive, connection.heads);
+    const bool inline_content = response.GetContent().size() <= MAX_INLINE_CONTENT;
+    if (inline_content) {
+        connection.heads += response.GetContent();
+    }
+    const size_t size = connection.heads.size() - begin;
+    connection.pending += size;
+    // Сусідні шматки heads відправляються одним iovec
+    if (!connection.chunks.empty() && connection.chunks.back().data == nullptr &&
+        connection.chunks.back().offset + connection.chunks.back().size == begin) {
+        connection.chunks.back().size += size;
+    } else {
+        connection.chunks.push_back({nullptr, begin, size, false});
+    }
+
+    if (!inline_content) {
+        connection.bodies.push_back(std::move(response));
+        const string& content = connection.bodies.back().GetContent();
+        connection.chunks.push_back({content.data(), 0, content.size(), true});
+        connection.pending += content.size();
+    }
+}
+
+void HttpServer::CompactHeads(Connection& connection) {
+    // Шматки heads у черзі йдуть за зростанням зміщення, тож усе до першого з них відправлено
+    size_t sent = connection.heads.size();
+    for (const Chunk& chunk : connection.chunks) {
+        if (chunk.data == nullptr) {
+            sent = chunk.offset;
+            break;
+        }
+    }
+    // Зсув лише коли відправлене не менше за решту: кожен байт переноситься в середньому O(1) разів
+    if (sent < MIN_HEADS_COMPACTION || sent < connection.heads.size() - sent) {
+        return;
+    }
+    connection.heads.erase(0, sent);
+    for (Chunk& chunk : connection.chunks) {
+        if (chunk.data == nullptr) {
+            chunk.offset -= sent;
+        }
+    }
+}
+
+bool HttpServer::Flush(int fd, Connection& connection) {
+    while (!connection.chunks.empty()) {
+        iovec parts[MAX_IOVECS];
+        size_t count = 0;
+        for (auto it = connection.chunks.begin(); it != connection.chunks.end() && count < MAX_IOVECS; ++it) {
+            const char* data = it->data ? it->data : connection.heads.data() + it->offset;
+            parts[count++] = {const_cast<char*>(data), it->size};
+        }
+        // sendmsg замість writev заради MSG_NOSIGNAL
+        msghdr message{};
+        message.msg_iov = parts;
+        message.msg_iovlen = count;
+        const ssize_t written = sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                break;
+            }
+            Close(fd);
+            return false;
+        }
+
+        connection.pending -= written;
+        for (size_t left = written; left > 0; ) {
+            Chunk& front = connection.chunks.front();
+            if (left < front.size) {
+                if (front.data) {
+                    front.data += left;
+                } else {
+                    front.offset += left;
+                }
+                front.size -= left;
+                break;
+            }
+            left -= front.size;
+            if (front.owns_body) {
+                connection.bodies.pop_front();
+            }
+            connection.chunks.pop_front();
+        }
+    }
+    CompactHeads(connection);
+    if (connection.chunks.empty()) {
+        connection.heads.clear();
+        // Після відправлення черги можна продовжити з уже прочитаними запитами,
+        // зокрема й після того, як клієнт закрив свій бік: 400 і Connection: close
+        // вже спорожнили input, тож лишитись там може лише неповний запит
+        if (!connection.input.empty()) {
+            ProcessRequests(connection);
+            if (!connection.chunks.empty()) {
+                return Flush(fd, connection);
+            }
+        }
+        if (connection.close_after_write) {
+            Close(fd);
+            return false;
+        }
+    }
+    return true;
+}
+
+void HttpServer::UpdateEvents(int fd, const Connection& connection) {
+    epoll_event event{};
+    const bool backlog = connection.pending > MAX_PENDING_OUTPUT;
+    if (connection.reading && !backlog) {
+        event.events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (!connection.chunks.empty()) {
+        event.events |= EPOLLOUT;
+    }
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void HttpServer::Close(int fd) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "http.h"
+#include "http_parser.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Розбирає один запит HTTP/1.x з початку data.
+// Повертає кількість спожитих байтів або 0, якщо запит ще не надійшов повністю;
+// keep_alive - чи лишати з'єднання відкритим після відповіді.
+// Зламаний або завеликий запит кидає std::invalid_argument
+size_t ParseHttpRequest(std::string_view data, HttpRequest& request, bool& keep_alive);
+
+// Неблокуючий HTTP/1.1 сервер на epoll (лише Linux).
+// Один потік обслуговує всі з'єднання: запити розбираються з буфера з'єднання
+// по мірі надходження, кілька запитів в одному пакеті (pipelining) обробляються
+// по черзі, відповіді йдуть у тому ж порядку. З'єднання живе, доки клієнт
+// не попросить Connection: close (для HTTP/1.0 - доки не попросить keep-alive).
+// Виключення з обробника перетворюється на 400 Bad request
+class HttpServer {
+public:
+    // Поля запиту вказують у буфер з'єднання і дійсні лише під час виклику
+    using Handler = std::function<HttpResponse(const HttpRequestView&)>;
+
+    // Слухає host:port; порт 0 - будь-який вільний, його повертає Port()
+    explicit HttpServer(Handler handler, const std::string& host = "127.0.0.1", uint16_t port = 0);
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+    ~HttpServer();
+
+    uint16_t Port() const;
+    // Цикл подій; повертається після Stop()
+    void Run();
+    // Можна викликати з будь-якого потоку
+    void Stop();
+
+private:
+    // Шматок черги на відправлення: зріз heads (data == nullptr) або чужі байти
+    struct Chunk {
+        const char* data = nullptr;
+        size_t offset = 0;
+        size_t size = 0;
+        // Байти - тіло bodies.front()
+        bool owns_body = false;
+    };
+
+    struct Connection {
+        std::string input;
+        // Стан розбору запиту, що ще надходить, між подіями
+        HttpRequestParser parser;
+        // Заголовки й короткі тіла відповідей підряд; пам'ять лишається після відправлення
+        std::string heads;
+        // Відповіді з довгими тілами, що ще відправляються; deque не переміщує елементи
+        std::deque<HttpResponse> bodies;
+        std::deque<Chunk> chunks;
+        size_t pending = 0;
+        bool close_after_write = false;
+        bool reading = true;
+    };
+
+    void AcceptAll();
+    void OnEvent(int fd, uint32_t events);
+    void ProcessRequests(Connection& connection);
+    // Заголовки рендеряться в heads, довге тіло чи готова відповідь відправляються без копіювання
+    void Enqueue(Connection& connection, HttpResponse response, bool keep_alive);
+    // Повільний читач на живому з'єднанні може ніколи не спорожнити чергу повністю,
+    // тож вже відправлений початок heads звільняється окремо
+    void CompactHeads(Connection& connection);
+    // false, якщо з'єднання закрито
+    bool Flush(int fd, Connection& connection);
+    void UpdateEvents(int fd, const Connection& connection);
+    void Close(int fd);
+
+    Handler handler;
+    int listen_fd = -1;
+    int epoll_fd = -1;
+    int wake_fd = -1;
+    // Запасний дескриптор на випадок EMFILE, див. AcceptAll
+    int reserve_fd = -1;
+    uint16_t port = 0;
+    std::unordered_map<int, Connection> connections;
+};
@@ -1,223 +1,338 @@
+#include "comment_server.h"
+#include "http.h"
+#include "http_server.h"
 #include "test_runner.h"
 #include <iostream>
 #include <vector>
 #include <map>
 #include <set>
 #include <string>
-#include <unordered_set>
-#include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
-enum class HttpCode {
-    Ok = 200,
-    NotFound = 404,
-    Found = 302,
-};
-
-ostream& operator<<(ostream& output, HttpCode code) {
-    switch (code) {
-        case HttpCode::Ok:
-            output << "200 OK";
-            break;
-        case HttpCode::Found:
-            output << "302 Found";
-            break;
-        case HttpCode::NotFound:
-            output << "404 Not found";
-            break;
-        default:
-            throw invalid_argument("Unknown HTTP code");
-    }
-    return output;
-}
+// Тестування
+void TestHttpResponse() {
+    HttpResponse response(HttpCode::Ok);
+    response.AddHeader("Header1", "Value1").SetContent("Body").SetCode(HttpCode::Found);
 
-struct HttpHeader {
-    string name, value;
-};
+    ostringstream output;
+    output << response;
 
-bool operator==(const HttpHeader& lhs, const HttpHeader& rhs) {
-    return lhs.name == rhs.name && lhs.value == rhs.value;
+    ASSERT_EQUAL(output.str(),
+                 "HTTP/1.1 302 Found\n"
+                 "Header1: Value1\n"
+                 "Content-Length: 4\n\n"
+                 "Body");
 }
 
-ostream& operator<<(ostream& output, const HttpHeader& header) {
-    return output << header.name << ": " << header.value;
-}
+void TestCommentServer() {
+    CommentServer server;
 
-class HttpResponse {
-public:
-    explicit HttpResponse(HttpCode code) : code(code) {}
+    HttpRequest add_user_request;
+    add_user_request.method = "POST";
+    add_user_request.path = "/add_user";
+    auto response = server.ServeRequest(add_user_request);
+    ASSERT_EQUAL(response, HttpResponse(HttpCode::Ok).SetContent("0"));
 
-    HttpResponse& AddHeader(string name, string value) {
-        headers.push_back({move(name), move(value)});
-        return *this;
+    // Той самий обробник над зрізами буфера
+    const string data = "POST /add_comment HTTP/1.1\r\nContent-Length: 7\r\n\r\n0 hello"
+                        "GET /user_comments?user_id=0 HTTP/1.1\r\n\r\n";
+    HttpRequestParser parser;
+    HttpRequestView request;
+    const size_t size = parser.Parse(data, request);
+    ASSERT_EQUAL(server.ServeRequest(request), HttpResponse(HttpCode::Ok));
+    parser.Parse(string_view(data).substr(size), request);
+    ASSERT_EQUAL(server.ServeRequest(request), HttpResponse(HttpCode::Ok).SetContent("hello\n"));
+
+    const auto [id, content] = ParseIdAndContent("12 a b");
+    ASSERT_EQUAL(id, 12u);
+    ASSERT_EQUAL(content, "a b");
+    ASSERT_EQUAL(ParseIdAndContent("3").first, 3u);
+    for (const char* bad : {"", " x", "-1 x", "1x y", "99999999999999999999999 x"}) {
+        try {
+            ParseIdAndContent(bad);
+            ASSERT(false);
+        } catch (const invalid_argument&) {
+        }
     }
+}
 
-    HttpResponse& SetContent(string content) {
-        this->content = move(content);
-        return *this;
+void TestStaticResponse() {
+    CommentServer server;
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/captcha";
+    HttpResponse captcha = server.ServeRequest(request);
+    ASSERT(captcha.GetPrepared() != nullptr);
+
+    const HttpResponse expected = HttpResponse(HttpCode::Ok)
+        .SetContent("What's the answer for The Ultimate Question of Life, the Universe, and Everything?");
+    ASSERT_EQUAL(captcha, expected);
+    for (bool keep_alive : {true, false}) {
+        string prepared, rendered;
+        AppendHttpResponse(captcha, keep_alive, prepared);
+        AppendHttpResponse(expected, keep_alive, rendered);
+        ASSERT_EQUAL(prepared, rendered);
     }
 
-    HttpResponse& SetCode(HttpCode code) {
-        this->code = code;
-        return *this;
-    }
+    // Зміна робить власну копію і не чіпає спільну відповідь
+    captcha.SetCode(HttpCode::NotFound);
+    ASSERT(captcha.GetPrepared() == nullptr);
+    ASSERT_EQUAL(captcha.GetContent(), expected.GetContent());
+    ASSERT_EQUAL(server.ServeRequest(request), expected);
+}
 
-    bool operator==(const HttpResponse& other) const {
-        return code == other.code &&
-               headers == other.headers &&
-               content == other.content;
+void TestParseHttpRequest() {
+    HttpRequest request;
+    bool keep_alive = false;
+    const string data = "GET /user_comments?user_id=3&x= HTTP/1.1\r\nHost: a\r\n\r\n"
+                        "POST /add_comment HTTP/1.0\r\ncontent-length: 7\r\n\r\n0 hello";
+    const size_t first = ParseHttpRequest(data, request, keep_alive);
+    ASSERT_EQUAL(request.method, "GET");
+    ASSERT_EQUAL(request.path, "/user_comments");
+    ASSERT_EQUAL(request.get_params.at("user_id"), "3");
+    ASSERT_EQUAL(request.get_params.at("x"), "");
+    ASSERT(keep_alive);
+
+    ASSERT_EQUAL(ParseHttpRequest(string_view(data).substr(first, data.size() - first - 1), request, keep_alive), 0u);
+    ASSERT_EQUAL(ParseHttpRequest(string_view(data).substr(first), request, keep_alive), data.size() - first);
+    ASSERT_EQUAL(request.body, "0 hello");
+    ASSERT(!keep_alive);
+
+    for (const char* bad : {"GET /\r\n\r\n",
+                            "POST / HTTP/1.1\r\nContent-Length: 1\r\ncontent-length: 2\r\n\r\nab"}) {
+        try {
+            ParseHttpRequest(bad, request, keep_alive);
+            ASSERT(false);
+        } catch (const invalid_argument&) {
+        }
     }
+    // Однакові повтори дозволені
+    ASSERT_EQUAL(ParseHttpRequest("POST / HTTP/1.1\r\nContent-Length: 2\r\nContent-Length: 2\r\n\r\nab",
+                                  request, keep_alive), 59u);
+    ASSERT_EQUAL(request.body, "ab");
+
+    string output;
+    AppendHttpResponse(HttpResponse(HttpCode::Ok).SetContent("0"), false, output);
+    ASSERT_EQUAL(output, "HTTP/1.1 200 OK\r\nContent-Length: 1\r\nConnection: close\r\n\r\n0");
+}
 
-    friend ostream& operator<<(ostream& output, const HttpResponse& resp) {
-        output << "HTTP/1.1 " << resp.code << "\n";
-        for (const auto& header : resp.headers) {
-            output << header << "\n";
+void TestHttpRequestParser() {
+    const string data = "\r\nGET /user_comments?user_id=3&empty&x=1&x=2 HTTP/1.1\r\nContent-Length: 4\r\n\r\nbody"
+                        "POST /add_user HTTP/1.0\n\n";
+    HttpRequestParser parser;
+    HttpRequestView request;
+
+    // Буфер надходить по байту і щоразу переїжджає в нову пам'ять
+    size_t size = 0;
+    for (size_t length = 0; size == 0; ++length) {
+        ASSERT(length <= data.size());
+        const string chunk = data.substr(0, length);
+        size = parser.Parse(chunk, request);
+        if (size > 0) {
+            ASSERT_EQUAL(request.method, "GET");
+            ASSERT_EQUAL(request.path, "/user_comments");
+            ASSERT_EQUAL(request.body, "body");
+            ASSERT_EQUAL(request.param_count, 4u);
+            ASSERT_EQUAL(*request.GetParam("user_id"), "3");
+            ASSERT_EQUAL(*request.GetParam("empty"), "");
+            ASSERT_EQUAL(*request.GetParam("x"), "1");
+            ASSERT(!request.GetParam("y"));
+            ASSERT(request.keep_alive);
         }
-        if (!resp.content.empty()) {
-            output << "Content-Length: " << resp.content.size() << "\n";
-        }
-        return output << "\n" << resp.content;
     }
 
-private:
-    HttpCode code;
-    vector<HttpHeader> headers;
-    string content;
-};
-
-struct HttpRequest {
-    string method, path, body;
-    map<string, string> get_params;
-};
-
-pair<string, string> SplitBy(const string& what, const string& by) {
-    size_t pos = what.find(by);
-    if (by.size() < what.size() && pos < what.size() - by.size()) {
-        return {what.substr(0, pos), what.substr(pos + by.size())};
-    } else {
-        return {what, {}};
-    }
-}
+    ASSERT_EQUAL(parser.Parse(string_view(data).substr(size), request), data.size() - size);
+    ASSERT_EQUAL(request.method, "POST");
+    ASSERT_EQUAL(request.path, "/add_user");
+    ASSERT_EQUAL(request.param_count, 0u);
+    ASSERT(!request.keep_alive);
 
-template<typename T>
-T FromString(const string& s) {
-    T x;
-    istringstream is(s);
-    is >> x;
-    return x;
-}
+    const HttpRequest copy = ToRequest(request);
+    ASSERT_EQUAL(copy.path, "/add_user");
 
-pair<size_t, string> ParseIdAndContent(const string& body) {
-    auto [id_string, content] = SplitBy(body, " ");
-    return {FromString<size_t>(id_string), content};
+    // Зайві параметри відкидаються, а не роблять запит зламаним
+    string many = "GET /?";
+    for (size_t i = 0; i <= HttpRequestView::MAX_PARAMS; ++i) {
+        many += "p" + to_string(i) + "=" + to_string(i) + "&";
+    }
+    many += " HTTP/1.1\r\n\r\n";
+    ASSERT_EQUAL(parser.Parse(many, request), many.size());
+    ASSERT_EQUAL(request.param_count, HttpRequestView::MAX_PARAMS);
+    ASSERT_EQUAL(*request.GetParam("p15"), "15");
+    ASSERT(!request.GetParam("p16"));
 }
 
-struct LastCommentInfo {
-    size_t user_id, consecutive_count;
-};
-
-class CommentServer {
-public:
-    HttpResponse ServeRequest(const HttpRequest& req) {
-        if (req.method == "POST") {
-            if (req.path == "/add_user") {
-                return ServeAddUser();
-            } else if (req.path == "/add_comment") {
-                return ServeAddComment(req);
-            } else if (req.path == "/check_captcha") {
-                return ServeCheckCaptcha(req);
-            }
-        } else if (req.method == "GET") {
-            if (req.path == "/user_comments") {
-                return ServeUserComments(req);
-            } else if (req.path == "/captcha") {
-                return ServeCaptcha();
-            }
-        }
-        return HttpResponse(HttpCode::NotFound);
+#ifdef __linux__
+// Надсилає data одним write і читає все до закриття з'єднання сервером.
+// half_close - після запитів закрити свій бік на запис, як робить клієнт, що більше нічого не надішле
+string Exchange(uint16_t port, const string& data, bool half_close = false) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT(connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+    ASSERT_EQUAL(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    if (half_close) {
+        ASSERT(shutdown(fd, SHUT_WR) == 0);
     }
 
-private:
-    HttpResponse ServeAddUser() {
-        comments_.emplace_back();
-        return HttpResponse(HttpCode::Ok).SetContent(to_string(comments_.size() - 1));
+    string result;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = read(fd, buffer, sizeof(buffer))) > 0) {
+        result.append(buffer, received);
     }
+    close(fd);
+    return result;
+}
 
-    HttpResponse ServeAddComment(const HttpRequest& req) {
-        auto [user_id, comment] = ParseIdAndContent(req.body);
-        if (!last_comment || last_comment->user_id != user_id) {
-            last_comment = {user_id, 1};
-        } else if (++last_comment->consecutive_count > 3) {
-            banned_users.insert(user_id);
-        }
+void TestHttpServer() {
+    CommentServer comments;
+    HttpServer server([&comments](const HttpRequestView& request) {
+        return comments.ServeRequest(request);
+    });
+    thread loop([&server] { server.Run(); });
+
+    // Три запити в одному пакеті; останній просить закрити з'єднання
+    const string pipelined =
+        "POST /add_user HTTP/1.1\r\n\r\n"
+        "POST /add_user HTTP/1.1\r\nContent-Length: 0\r\n\r\n"
+        "POST /add_comment HTTP/1.1\r\nContent-Length: 7\r\nConnection: close\r\n\r\n1 hello";
+    ASSERT_EQUAL(Exchange(server.Port(), pipelined),
+                 "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\n0"
+                 "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\n1"
+                 "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+
+    // HTTP/1.0 без keep-alive закривається після першої відповіді
+    ASSERT_EQUAL(Exchange(server.Port(), "GET /user_comments?user_id=1 HTTP/1.0\r\n\r\n"),
+                 "HTTP/1.1 200 OK\r\nContent-Length: 6\r\nConnection: close\r\n\r\nhello\n");
+    // Невідомий користувач - виключення в обробнику
+    ASSERT_EQUAL(Exchange(server.Port(), "GET /user_comments?user_id=9 HTTP/1.0\r\n\r\n"),
+                 "HTTP/1.1 400 Bad request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    ASSERT_EQUAL(Exchange(server.Port(), "GET /captcha HTTP/1.0\r\n\r\n"),
+                 "HTTP/1.1 200 OK\r\nContent-Length: 82\r\nConnection: close\r\n\r\n"
+                 "What's the answer for The Ultimate Question of Life, the Universe, and Everything?");
+    // Номер користувача не число
+    ASSERT_EQUAL(Exchange(server.Port(), "POST /add_comment HTTP/1.0\r\nContent-Length: 7\r\n\r\nx hello"),
+                 "HTTP/1.1 400 Bad request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    ASSERT_EQUAL(Exchange(server.Port(), "garbage\r\n\r\n"),
+                 "HTTP/1.1 400 Bad request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+
+    server.Stop();
+    loop.join();
+}
 
-        if (banned_users.count(user_id) == 0) {
-            comments_[user_id].push_back(comment);
-            return HttpResponse(HttpCode::Ok);
-        } else {
-            return HttpResponse(HttpCode::Found).AddHeader("Location", "/captcha");
-        }
+void TestHttpServerOutOfDescriptors() {
+    HttpServer server([](const HttpRequestView&) {
+        return HttpResponse(HttpCode::Ok);
+    });
+    thread loop([&server] { server.Run(); });
+
+    // Займаємо всю таблицю дескрипторів, лишивши місце лише для клієнта
+    rlimit original;
+    ASSERT(getrlimit(RLIMIT_NOFILE, &original) == 0);
+    rlimit limited = original;
+    limited.rlim_cur = 64;
+    ASSERT(setrlimit(RLIMIT_NOFILE, &limited) == 0);
+    vector<int> fillers;
+    for (int fd; (fd = open("/dev/null", O_RDONLY | O_CLOEXEC)) >= 0; ) {
+        fillers.push_back(fd);
     }
-
-    HttpResponse ServeCheckCaptcha(const HttpRequest& req) {
-        auto [id, response] = ParseIdAndContent(req.body);
-        if (response == "42") {
-            banned_users.erase(id);
-            return HttpResponse(HttpCode::Ok);
-        }
-        return HttpResponse(HttpCode::Found).AddHeader("Location", "/captcha");
+    // Без жодного заповнювача таблиця вже була повна і клієнтові місця немає
+    if (fillers.empty()) {
+        setrlimit(RLIMIT_NOFILE, &original);
     }
-
-    HttpResponse ServeUserComments(const HttpRequest& req) {
-        auto user_id = FromString<size_t>(req.get_params.at("user_id"));
-        string response;
-        for (const auto& comment : comments_[user_id]) {
-            response += comment + "\n";
-        }
-        return HttpResponse(HttpCode::Ok).SetContent(move(response));
+    ASSERT(!fillers.empty());
+    close(fillers.back());
+    fillers.pop_back();
+
+    const int client = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT(client >= 0);
+    const timeval timeout{5, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(server.Port());
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT(connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+    // Сервер не може прийняти з'єднання і закриває його замість того, щоб крутитись на EMFILE
+    char byte;
+    ASSERT_EQUAL(read(client, &byte, 1), 0);
+    close(client);
+
+    for (int fd : fillers) {
+        close(fd);
     }
+    setrlimit(RLIMIT_NOFILE, &original);
+    ASSERT_EQUAL(Exchange(server.Port(), "GET / HTTP/1.0\r\n\r\n"),
+                 "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
 
-    HttpResponse ServeCaptcha() {
-        return HttpResponse(HttpCode::Ok)
-            .SetContent("What's the answer for The Ultimate Question of Life, the Universe, and Everything?");
-    }
-
-    vector<vector<string>> comments_;
-    optional<LastCommentInfo> last_comment;
-    unordered_set<size_t> banned_users;
-};
-
-// Тестування
-void TestHttpResponse() {
-    HttpResponse response(HttpCode::Ok);
-    response.AddHeader("Header1", "Value1").SetContent("Body").SetCode(HttpCode::Found);
-
-    ostringstream output;
-    output << response;
-
-    ASSERT_EQUAL(output.str(),
-                 "HTTP/1.1 302 Found\n"
-                 "Header1: Value1\n"
-                 "Content-Length: 4\n\n"
-                 "Body");
+    server.Stop();
+    loop.join();
 }
 
-void TestCommentServer() {
-    CommentServer server;
+void TestHttpServerLargeResponses() {
+    // Тіла більші за буфер сокета: відправлення частинами між подіями
+    HttpServer server([](const HttpRequestView& request) {
+        const size_t size = stoul(string(request.GetParam("size").value()));
+        return HttpResponse(HttpCode::Ok).SetContent(string(size, 'a' + size % 26));
+    });
+    thread loop([&server] { server.Run(); });
+
+    string requests, expected;
+    vector<size_t> sizes = {3, 3'000'000, 10, 700, 5'000'000};
+    // Багато коротких відповідей між довгими: heads ущільнюється, поки черга не порожня
+    for (size_t i = 0; i < 1000; ++i) {
+        sizes.push_back(i % 100 == 0 ? 200'000 : 400);
+    }
+    sizes.push_back(1);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        const bool last = i + 1 == sizes.size();
+        requests += "GET /?size=" + to_string(sizes[i]) + " HTTP/1.1\r\n" + (last ? "Connection: close\r\n" : "") + "\r\n";
+        AppendHttpResponse(HttpResponse(HttpCode::Ok).SetContent(string(sizes[i], 'a' + sizes[i] % 26)), !last, expected);
+    }
+    ASSERT(Exchange(server.Port(), requests) == expected);
+
+    // Клієнт закрив свій бік, поки решта запитів чекала на спорожнення черги:
+    // відповіді на всі вже отримані запити все одно надсилаються
+    requests.clear();
+    expected.clear();
+    for (size_t i = 0; i < 200; ++i) {
+        requests += "GET /?size=100000 HTTP/1.1\r\n\r\n";
+        AppendHttpResponse(HttpResponse(HttpCode::Ok).SetContent(string(100'000, 'a' + 100'000 % 26)), true, expected);
+    }
+    ASSERT(Exchange(server.Port(), requests, true) == expected);
 
-    HttpRequest add_user_request;
-    add_user_request.method = "POST";
-    add_user_request.path = "/add_user";
-    auto response = server.ServeRequest(add_user_request);
-    ASSERT_EQUAL(response, HttpResponse(HttpCode::Ok).SetContent("0"));
+    server.Stop();
+    loop.join();
 }
+#endif
 
 int main() {
     TestRunner tr;
     RUN_TEST(tr, TestHttpResponse);
     RUN_TEST(tr, TestCommentServer);
+    RUN_TEST(tr, TestStaticResponse);
+    RUN_TEST(tr, TestParseHttpRequest);
+    RUN_TEST(tr, TestHttpRequestParser);
+#ifdef __linux__
+    RUN_TEST(tr, TestHttpServer);
+    RUN_TEST(tr, TestHttpServerLargeResponses);
+    RUN_TEST(tr, TestHttpServerOutOfDescriptors);
+#endif
     return 0;
 }
\ No newline at end of file